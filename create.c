@@ -47,6 +47,7 @@
 
 #include "pthread.h"
 #include "implement.h"
+#include "sched.h"
 
 extern unsigned int _pthread_stack_default_user __attribute__((weak));
 
@@ -86,7 +87,8 @@ pthread_create (pthread_t * tid,
  *
  * RESULTS
  *              0               successfully created thread,
- *              EINVAL          attr invalid,
+ *              EINVAL          attr invalid, or its priority is
+ *                              outside the range of its policy,
  *              EAGAIN          insufficient resources.
  *
  * ------------------------------------------------------
@@ -97,6 +99,7 @@ pthread_create (pthread_t * tid,
   register pthread_attr_t a;
   int result = EAGAIN;
   int run = PTE_TRUE;
+  int policy = SCHED_OTHER;
   ThreadParms *parms = NULL;
   long stackSize;
   int priority = 0;
@@ -146,9 +149,10 @@ pthread_create (pthread_t * tid,
       stackSize = a->stacksize;
       tp->detachState = a->detachstate;
       priority = a->param.sched_priority;
+      policy = a->policy;
 
-      if ( (priority > pte_osThreadGetMaxPriority()) ||
-           (priority < pte_osThreadGetMinPriority()) )
+      if ( (priority > sched_get_priority_max (policy)) ||
+           (priority < sched_get_priority_min (policy)) )
         {
           result = EINVAL;
           goto FAIL0;
@@ -170,6 +174,7 @@ pthread_create (pthread_t * tid,
            */
           self = pthread_self ();
           priority = ((pte_thread_t *) self)->sched_priority;
+          policy = ((pte_thread_t *) self)->sched_policy;
         }
 
 
@@ -204,6 +209,7 @@ pthread_create (pthread_t * tid,
        * not as finally adjusted.
        */
       tp->sched_priority = priority;
+      tp->sched_policy = policy;
 
       (void) pthread_mutex_unlock (&tp->threadLock);
     }
@@ -216,6 +222,13 @@ pthread_create (pthread_t * tid,
 
   if (osResult == PTE_OS_OK)
     {
+      PTE_TRACE_EVENT (PTE_TRACE_THREAD_CREATE, thread);
+
+      if (policy == SCHED_RR)
+        {
+          pte_rrStart (priority);
+        }
+
       pte_osThreadStart(tp->threadId);
       result = 0;
     }
@@ -48,6 +48,7 @@
 hidden int pte_processInitialized = PTE_FALSE;
 hidden pte_thread_t * pte_threadReuseTop = PTE_THREAD_REUSE_EMPTY;
 hidden pte_thread_t * pte_threadReuseBottom = PTE_THREAD_REUSE_EMPTY;
+hidden pte_thread_t * pte_threadList = NULL;
 hidden pthread_key_t pte_selfThreadKey = NULL;
 hidden pthread_key_t pte_cleanupKey = NULL;
 hidden pthread_cond_t pte_cond_list_head = NULL;
@@ -55,6 +56,12 @@ hidden pthread_cond_t pte_cond_list_tail = NULL;
 
 hidden int pte_concurrency = 0;
 
+/* Set from pte_concurrency by pthread_setconcurrency(); 0 until then */
+hidden int pte_mutexSpinCount = 0;
+
+/* State of the SCHED_RR time slicing thread, see pte_rr.c */
+hidden int pte_rrState = PTE_RR_IDLE;
+
 /* What features have been auto-detaected */
 hidden int pte_features = 0;
 
@@ -95,4 +102,34 @@ hidden pte_osMutexHandle pte_spinlock_test_init_lock;
  */
 hidden pte_osMutexHandle pte_cond_list_lock;
 
+#ifdef PTE_STATS
+/*
+ * Counters for pthread_getstats_np(), indexed by PTE_STAT_*.
+ */
+hidden int pte_stats[PTE_STAT_COUNT];
+#endif
+
+#ifdef PTE_TRACE
+/*
+ * Event tracing state, see pte_trace.c.
+ */
+hidden int pte_traceEnabled = 0;
+hidden int pte_traceRingCount = 0;
+hidden pte_trace_ring_t * pte_traceRings[PTE_TRACE_MAX_RINGS];
+hidden pte_trace_ring_t pte_traceSharedRing;
+#endif
+
+#ifdef PTE_HOOKS
+/*
+ * Instrumentation hooks, see pthread_sethooks_np().
+ */
+hidden pthread_hooks_np_t pte_hooks;
+#endif
 
+/*
+ * Contention sampling state, see pte_profile.c.
+ */
+hidden int pte_profilePeriod = 0;
+hidden int pte_profileDropped = 0;
+hidden int pte_profileActive = 0;
+hidden pte_profile_site_t pte_profileSites[PTE_PROFILE_SITES];
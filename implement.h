@@ -51,6 +51,8 @@
 #ifndef _IMPLEMENT_H
 #define _IMPLEMENT_H
 
+#include <stddef.h>
+
 #include "pte_osal.h"
 
 /* use local include files during development */
@@ -95,6 +97,7 @@ struct pte_thread_t_
     int detachState;
     pthread_mutex_t threadLock;	/* Used for serialised access to public thread state */
     int sched_priority;		/* As set, not as currently is */
+    int sched_policy;
     pthread_mutex_t cancelLock;	/* Used for async-cancel safety */
     int cancelState;
     int cancelType;
@@ -106,6 +109,19 @@ int implicit:
     1;
     void *keys;
     void *nextAssoc;
+#ifdef PTE_TRACE
+    void *traceRing;		/* Event ring claimed by this thread, see pte_trace.c */
+#endif
+    volatile int waitKind;	/* What the thread is blocked on, see pte_wait.c */
+    void * volatile waitObject;
+    unsigned long long waitStart;
+    int profileTick;		/* Contended locks since the last sample, see pte_profile.c */
+    pte_osSemaphoreHandle parkSem;	/* Kept across reuse, see pte_park.c */
+    int parkSemCreated;
+    volatile int parkWoken;
+    pte_thread_t * parkNext;	/* Links threads parked on the same object */
+    int parkExclusive;		/* Parked for exclusive access (rwlock writer) */
+    pte_thread_t * nextThread;	/* Links every pte_thread_t ever allocated */
   };
 
 
@@ -123,6 +139,7 @@ struct pthread_attr_t_
     struct sched_param param;
     int inheritsched;
     int contentionscope;
+    int policy;
   };
 
 
@@ -144,9 +161,18 @@ struct sem_t_
 #define PTE_OBJECT_AUTO_INIT ((void *) -1)
 #define PTE_OBJECT_INVALID   0
 
+/*
+ * SEM_INITIALIZER_NP() and PTHREAD_BARRIER_INITIALIZER_NP() store
+ * their count shifted left in an odd pointer value, which no real
+ * object can have.
+ */
+#define PTE_IS_COUNT_INITIALIZER(obj) (((unsigned long) (obj) & 1) != 0)
+#define PTE_COUNT_INITIALIZER_VALUE(obj) \
+  ((unsigned int) ((unsigned long) (obj) >> 1))
+
 struct pthread_mutex_t_
   {
-    pte_osSemaphoreHandle handle;
+    /* lock_idx and kind must stay first, see struct pte_mutex_head_np_t_ */
     int lock_idx;
     /* Provides exclusive access to mutex state
     				   via the Interlocked* mechanism.
@@ -154,10 +180,11 @@ struct pthread_mutex_t_
     				    1: locked - no other waiters.
     				   -1: locked - with possible other waiters.
     				*/
+    int kind;			/* Mutex type. */
+    pte_osSemaphoreHandle handle;
     int recursive_count;		/* Number of unlocks a thread needs to perform
 				   before the lock is released (recursive
 				   mutexes only). */
-    int kind;			/* Mutex type. */
     pthread_t ownerThread;
   };
 
@@ -165,6 +192,7 @@ struct pthread_mutexattr_t_
   {
     int pshared;
     int kind;
+    int wakeOrder;
   };
 
 /*
@@ -183,10 +211,9 @@ struct pthread_mutexattr_t_
  *
  * "u.cpus" isn't used for anything yet, but could be used at
  * some point to optimise spinlock behaviour.
+ *
+ * The values are defined in pthread.h for the inline fast paths.
  */
-#define PTE_SPIN_UNLOCKED    (1)
-#define PTE_SPIN_LOCKED      (2)
-#define PTE_SPIN_USE_MUTEX   (3)
 
 struct pthread_spinlock_t_
   {
@@ -198,13 +225,26 @@ struct pthread_spinlock_t_
       } u;
   };
 
+/*
+ * The inline fast paths in pthread.h (PTHREAD_INLINE_FAST_PATHS_NP)
+ * only see these leading members; fail the build if they move.
+ */
+typedef char pte_check_mutex_head[
+  (offsetof (struct pthread_mutex_t_, lock_idx) ==
+     offsetof (struct pte_mutex_head_np_t_, lock_idx) &&
+   offsetof (struct pthread_mutex_t_, kind) ==
+     offsetof (struct pte_mutex_head_np_t_, kind)) ? 1 : -1];
+
+typedef char pte_check_spinlock_head[
+  offsetof (struct pthread_spinlock_t_, interlock) ==
+    offsetof (struct pte_spinlock_head_np_t_, interlock) ? 1 : -1];
+
 struct pthread_barrier_t_
   {
-    unsigned int nCurrentBarrierHeight;
-    unsigned int nInitialBarrierHeight;
-    int iStep;
+    volatile int remaining;	/* Threads still to arrive in this cycle */
+    unsigned int count;
     int pshared;
-    sem_t semBarrierBreeched[2];
+    pte_thread_t * volatile waiters;	/* Parked threads, see pthread_barrier_wait.c */
   };
 
 struct pthread_barrierattr_t_
@@ -253,19 +293,24 @@ struct pthread_condattr_t_
   {
     int pshared;
     clockid_t clock;
+    int wakeOrder;
   };
 
 #define PTE_RWLOCK_MAGIC 0xfacade2
 
+/*
+ * rwlock state word, see pte_rwlock_wait.c.
+ */
+#define PTE_RWLOCK_WRITER  0x40000000	/* Held by a writer */
+#define PTE_RWLOCK_WAITERS 0x20000000	/* Threads are queued; unlock must dispatch */
+#define PTE_RWLOCK_READERS 0x1fffffff	/* Mask: number of readers holding it */
+
 struct pthread_rwlock_t_
   {
-    pthread_mutex_t mtxExclusiveAccess;
-    pthread_mutex_t mtxSharedAccessCompleted;
-    pthread_cond_t cndSharedAccessCompleted;
-    int nSharedAccessCount;
-    int nExclusiveAccessCount;
-    int nCompletedSharedAccessCount;
+    volatile int state;
     int nMagic;
+    pte_osMutexHandle queueLock;	/* Guards the queue; slow paths only */
+    pte_thread_t * waiters;		/* Parked threads, oldest first */
   };
 
 struct pthread_rwlockattr_t_
@@ -290,6 +335,182 @@ typedef struct pte_mcs_node_t_   pte_mcs_local_node_t;
 typedef struct pte_mcs_node_t_  *pte_mcs_lock_t;
 
 
+/*
+ * Synchronisation event tracing - see pte_trace.c.
+ *
+ * Only compiled in when PTE_TRACE is defined; otherwise the
+ * PTE_TRACE_* macros expand to nothing.
+ */
+typedef enum
+{
+  PTE_TRACE_MUTEX_CONTENDED = 0,
+  PTE_TRACE_MUTEX_ACQUIRED,	/* Only after PTE_TRACE_MUTEX_CONTENDED */
+  PTE_TRACE_MUTEX_RELEASED,	/* Only when there are waiters */
+  PTE_TRACE_COND_WAIT,
+  PTE_TRACE_COND_WAKE,
+  PTE_TRACE_SEM_BLOCK,
+  PTE_TRACE_SEM_WAKE,
+  PTE_TRACE_SEM_POST,		/* Only when there are waiters */
+  PTE_TRACE_THREAD_CREATE,
+  PTE_TRACE_THREAD_START,
+  PTE_TRACE_THREAD_EXIT,
+  PTE_TRACE_CANCEL,
+  PTE_TRACE_EVENT_TYPES
+}
+pte_trace_event_type;
+
+#ifdef PTE_TRACE
+
+#ifndef PTE_TRACE_RING_SIZE
+#define PTE_TRACE_RING_SIZE 512		/* Events per thread, power of two */
+#endif
+
+#ifndef PTE_TRACE_MAX_RINGS
+#define PTE_TRACE_MAX_RINGS 64
+#endif
+
+typedef struct
+  {
+    unsigned long long timestamp;	/* pte_osClockGetNanoseconds() */
+    void * object;
+    unsigned int thread;		/* OS thread handle */
+    int type;
+    volatile int seq;			/* 0 while being written, then ring index + 1 */
+  } pte_trace_event_t;
+
+/*
+ * A ring is written by the thread that claimed it (or by any
+ * thread for the shared overflow ring) and read lock-free by the
+ * exporter, which uses 'seq' to drop entries that were incomplete
+ * or overwritten while it was copying them.
+ */
+typedef struct
+  {
+    volatile int head;		/* Count of events ever written */
+    volatile int inUse;		/* Claimed by a live thread */
+    pte_trace_event_t events[PTE_TRACE_RING_SIZE];
+  } pte_trace_ring_t;
+
+#define PTE_TRACE_EVENT(type, obj) pte_traceEvent ((type), (void *) (obj))
+#define PTE_TRACE_THREAD_DONE(tp) pte_traceThreadDone (tp)
+
+#else /* PTE_TRACE */
+
+#define PTE_TRACE_EVENT(type, obj)
+#define PTE_TRACE_THREAD_DONE(tp)
+
+#endif /* PTE_TRACE */
+
+
+/*
+ * Blocking state recorded for pthread_dump_waits_np() - see pte_wait.c.
+ */
+typedef enum
+{
+  PTE_WAIT_NONE = 0,
+  PTE_WAIT_MUTEX = PTHREAD_HOOK_MUTEX_NP,	/* waitObject is the pthread_mutex_t */
+  PTE_WAIT_COND = PTHREAD_HOOK_COND_NP,		/* waitObject is the pthread_cond_t */
+  PTE_WAIT_SEM = PTHREAD_HOOK_SEM_NP,		/* waitObject is the sem_t */
+  PTE_WAIT_RWLOCK = PTHREAD_HOOK_RWLOCK_NP,	/* waitObject is the pthread_rwlock_t */
+  PTE_WAIT_BARRIER = PTHREAD_HOOK_BARRIER_NP,	/* waitObject is the pthread_barrier_t */
+  PTE_WAIT_JOIN = PTHREAD_HOOK_JOIN_NP,		/* waitObject is the target pte_thread_t */
+  PTE_WAIT_KINDS
+}
+pte_wait_kind;
+
+
+/*
+ * Instrumentation hooks installed with pthread_sethooks_np().
+ * before_block and after_wake are called from pte_waitBegin() and
+ * pte_waitEnd(); the rest from the call sites below.
+ *
+ * Only compiled in when PTE_HOOKS is defined; otherwise the
+ * PTE_HOOK_* macros expand to nothing.
+ */
+#ifdef PTE_HOOKS
+
+/* Copy the pointer first so a concurrent pthread_sethooks_np() can't NULL it. */
+#define PTE_HOOK_LOCK_ACQUIRED(mx) \
+  do { \
+    void (*hook_) (void *) = pte_hooks.lock_acquired; \
+    if (hook_ != NULL) hook_ ((void *) (mx)); \
+  } while (0)
+#define PTE_HOOK_LOCK_RELEASED(mx) \
+  do { \
+    void (*hook_) (void *) = pte_hooks.lock_released; \
+    if (hook_ != NULL) hook_ ((void *) (mx)); \
+  } while (0)
+#define PTE_HOOK_THREAD_START(thread) \
+  do { \
+    void (*hook_) (pthread_t) = pte_hooks.thread_start; \
+    if (hook_ != NULL) hook_ (thread); \
+  } while (0)
+#define PTE_HOOK_THREAD_EXIT(thread) \
+  do { \
+    void (*hook_) (pthread_t) = pte_hooks.thread_exit; \
+    if (hook_ != NULL) hook_ (thread); \
+  } while (0)
+
+#else /* PTE_HOOKS */
+
+#define PTE_HOOK_LOCK_ACQUIRED(mx)
+#define PTE_HOOK_LOCK_RELEASED(mx)
+#define PTE_HOOK_THREAD_START(thread)
+#define PTE_HOOK_THREAD_EXIT(thread)
+
+#endif /* PTE_HOOKS */
+
+
+/*
+ * A normal mutex records its owner only when it is taken after
+ * contention, for pthread_dump_waits_np(), and only in builds that
+ * already pay for PTE_HOOKS or PTE_TRACE: otherwise the unlock fast
+ * path would carry an extra store just to clear it.
+ */
+#if defined (PTE_HOOKS) || defined (PTE_TRACE)
+#define PTE_NORMAL_OWNER_SET(mx, waiter) ((mx)->ownerThread = (waiter)->ptHandle)
+#define PTE_NORMAL_OWNER_CLEAR(mx) ((mx)->ownerThread = 0)
+#else
+#define PTE_NORMAL_OWNER_SET(mx, waiter)
+#define PTE_NORMAL_OWNER_CLEAR(mx)
+#endif
+
+
+/*
+ * Contention sampling - see pte_profile.c.
+ *
+ * Contended mutex and rwlock locks call PTE_PROFILE_SAMPLE() with
+ * the record returned by pte_waitBegin() once they have the lock.
+ * It must be expanded in the public entry point itself so that the
+ * return address is the application's call site.
+ */
+#ifndef PTE_PROFILE_SITES
+#define PTE_PROFILE_SITES 64		/* Hash table slots, power of two */
+#endif
+
+typedef struct
+  {
+    volatile int state;			/* 0 free, 1 being claimed, 2 in use */
+    void * volatile site;
+    volatile int samples;
+    volatile int totalWaitUs;
+    volatile int maxWaitUs;
+  } pte_profile_site_t;
+
+#ifdef __GNUC__
+#define PTE_RETURN_ADDRESS() __builtin_return_address (0)
+#else
+#define PTE_RETURN_ADDRESS() NULL
+#endif
+
+#define PTE_PROFILE_SAMPLE(waiter) \
+  do { \
+    if (pte_profilePeriod != 0 && (waiter) != NULL && \
+        ++(waiter)->profileTick >= pte_profilePeriod) \
+      pte_profileSample ((waiter), PTE_RETURN_ADDRESS ()); \
+  } while (0)
+
+
 struct ThreadKeyAssoc
   {
     /*
@@ -412,6 +633,51 @@ struct ThreadKeyAssoc
 #define PTE_MAX(a,b)  ((a)<(b)?(b):(a))
 #define PTE_MIN(a,b)  ((a)>(b)?(b):(a))
 
+/*
+ * SCHED_RR time slicing, see pte_rr.c.
+ */
+#ifndef PTE_RR_QUANTUM_MSECS
+#define PTE_RR_QUANTUM_MSECS 10
+#endif
+
+#define PTE_RR_MAX_LEVELS     64	/* Distinct SCHED_RR priorities rotated per tick */
+
+#define PTE_RR_IDLE           0
+#define PTE_RR_STARTING       1
+#define PTE_RR_RUNNING        2
+#define PTE_RR_UNSUPPORTED    3
+
+/*
+ * How often timeout computations re-read the wall clock, rather than
+ * deriving it from pte_osClockGetNanoseconds(); see pte_relmillisecs.c.
+ */
+#ifndef PTE_CLOCK_RESYNC_USECS
+#define PTE_CLOCK_RESYNC_USECS 1000000
+#endif
+
+/*
+ * Times a contended pthread_mutex_lock() polls the mutex before it
+ * blocks, once pthread_setconcurrency() has been given a level no
+ * higher than the number of CPUs. Scaled down by higher levels; no
+ * polling at all until the application sets a level.
+ */
+#ifndef PTE_MUTEX_SPIN_COUNT
+#define PTE_MUTEX_SPIN_COUNT 100
+#endif
+
+/*
+ * Tells the CPU that the caller is busy waiting, so that it can save
+ * power or give a sibling hardware thread the pipeline.
+ */
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define PTE_CPU_RELAX() __asm__ __volatile__ ("pause" : : : "memory")
+#elif defined(__GNUC__) && (defined(__aarch64__) || \
+      (defined(__arm__) && defined(__ARM_ARCH) && __ARM_ARCH >= 7))
+#define PTE_CPU_RELAX() __asm__ __volatile__ ("yield" : : : "memory")
+#else
+#define PTE_CPU_RELAX() do { } while (0)
+#endif
+
 
 /* Thread Reuse stack bottom marker. Must not be NULL or any valid pointer to memory. */
 #define PTE_THREAD_REUSE_EMPTY ((pte_thread_t *) 1)
@@ -419,6 +685,7 @@ struct ThreadKeyAssoc
 extern int pte_processInitialized;
 extern pte_thread_t * pte_threadReuseTop;
 extern pte_thread_t * pte_threadReuseBottom;
+extern pte_thread_t * pte_threadList;
 extern pthread_key_t pte_selfThreadKey;
 extern pthread_key_t pte_cleanupKey;
 extern pthread_cond_t pte_cond_list_head;
@@ -427,6 +694,9 @@ extern pthread_cond_t pte_cond_list_tail;
 extern int pte_mutex_default_kind;
 
 extern int pte_concurrency;
+extern int pte_mutexSpinCount;
+
+extern int pte_rrState;
 
 extern int pte_features;
 
@@ -437,6 +707,22 @@ extern pte_osMutexHandle pte_cond_test_init_lock;
 extern pte_osMutexHandle pte_rwlock_test_init_lock;
 extern pte_osMutexHandle pte_spinlock_test_init_lock;
 
+#ifdef PTE_TRACE
+extern int pte_traceEnabled;
+extern int pte_traceRingCount;
+extern pte_trace_ring_t * pte_traceRings[PTE_TRACE_MAX_RINGS];
+extern pte_trace_ring_t pte_traceSharedRing;
+#endif
+
+#ifdef PTE_HOOKS
+extern pthread_hooks_np_t pte_hooks;
+#endif
+
+extern int pte_profilePeriod;
+extern int pte_profileDropped;
+extern int pte_profileActive;
+extern pte_profile_site_t pte_profileSites[PTE_PROFILE_SITES];
+
 
 #ifdef __cplusplus
 extern "C"
@@ -457,6 +743,10 @@ extern "C"
     hidden int pte_mutex_check_need_init (pthread_mutex_t * mutex);
     hidden int pte_rwlock_check_need_init (pthread_rwlock_t * rwlock);
     hidden int pte_spinlock_check_need_init (pthread_spinlock_t * lock);
+    hidden int pte_sem_check_need_init (sem_t * sem);
+    hidden int pte_barrier_check_need_init (pthread_barrier_t * barrier);
+
+    hidden int pte_mutex_next_in_order (pthread_mutex_t * const * mutexes, int count, int prev);
 
     hidden int pte_processInitialize (void);
 
@@ -477,7 +767,14 @@ extern "C"
 
     hidden int pte_setthreadpriority (pthread_t thread, int policy, int priority);
 
-    hidden void pte_rwlock_cancelwrwait (void *arg);
+    hidden void pte_rrStart (int priority);
+
+    hidden void pte_rrStop (void);
+
+    hidden int pte_rwlock_wait (pthread_rwlock_t rwl, int writer,
+                                const struct timespec * abstime);
+
+    hidden void pte_rwlock_wake (pthread_rwlock_t rwl);
 
     hidden int pte_threadStart (void *vthreadParms);
 
@@ -491,6 +788,11 @@ extern "C"
 
     hidden unsigned int pte_relmillisecs (const struct timespec * abstime);
 
+    hidden void pte_clockResync (void);
+
+    hidden int pte_reltimeout (const struct timespec * reltime,
+                               unsigned int * milliseconds);
+
     hidden void pte_mcs_lock_acquire (pte_mcs_lock_t * lock, pte_mcs_local_node_t * node);
 
     hidden void pte_mcs_lock_release (pte_mcs_local_node_t * node);
@@ -500,12 +802,51 @@ extern "C"
 
     hidden int pte_cancellable_wait (pte_osSemaphoreHandle semHandle, unsigned int* timeout);
 
+    hidden int pte_once (pthread_once_t * once_control,
+                         void (*init_routine) (void),
+                         int (*init_result) (void),
+                         const struct timespec * abstime,
+                         int cancellable);
+
+    hidden pte_thread_t * pte_waitBegin (int kind, void * object);
+    hidden void pte_waitEnd (pte_thread_t * waiter);
+
+    hidden int pte_parkPrepare (pte_thread_t * self);
+    hidden void pte_park (pte_thread_t * self);
+    hidden int pte_parkTimed (pte_thread_t * self, const unsigned int * pTimeout);
+    hidden void pte_unpark (pte_thread_t * tp);
+
+    hidden void pte_profileSample (pte_thread_t * waiter, void * site);
+
+#ifdef PTE_TRACE
+    hidden void pte_traceEvent (int type, void * object);
+    hidden void pte_traceThreadDone (pte_thread_t * tp);
+#endif
+
 #define PTE_ATOMIC_EXCHANGE pte_osAtomicExchange
 #define PTE_ATOMIC_EXCHANGE_ADD pte_osAtomicExchangeAdd
 #define PTE_ATOMIC_COMPARE_EXCHANGE pte_osAtomicCompareExchange
 #define PTE_ATOMIC_DECREMENT pte_osAtomicDecrement
 #define PTE_ATOMIC_INCREMENT pte_osAtomicIncrement
 
+/* Load ordered before the loads and stores that follow it. */
+#ifdef __GNUC__
+#define PTE_ATOMIC_LOAD_ACQUIRE(ptr) \
+  __atomic_load_n ((ptr), __ATOMIC_ACQUIRE)
+#else
+#define PTE_ATOMIC_LOAD_ACQUIRE(ptr) \
+  PTE_ATOMIC_EXCHANGE_ADD ((ptr), 0)
+#endif
+
+/* Pointer-sized compare and exchange, returns the previous value. */
+#ifdef __GNUC__
+#define PTE_ATOMIC_COMPARE_EXCHANGE_PTR(ptr, exch, comp) \
+  __sync_val_compare_and_swap ((ptr), (comp), (exch))
+#else
+#define PTE_ATOMIC_COMPARE_EXCHANGE_PTR(ptr, exch, comp) \
+  ((void *) PTE_ATOMIC_COMPARE_EXCHANGE ((int *) (ptr), (int) (exch), (int) (comp)))
+#endif
+
     hidden int  pte_thread_detach_np();
     hidden int  pte_thread_detach_and_exit_np();
 
@@ -31,6 +31,7 @@
 
 #include <std.h>
 #include <clk.h>
+#include <gbl.h>
 #include <lck.h>
 #include <mbx.h>
 
@@ -269,6 +270,8 @@ pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
   if (handle != NULL)
     {
       /* Everything worked, return handle to caller */
+      PTE_STAT_ADD(PTE_STAT_OS_THREADS, 1);
+      PTE_STAT_ADD(PTE_STAT_OS_THREADS_CREATED, 1);
       *ppte_osThreadHandle = handle;
       result = PTE_OS_OK;
     }
@@ -347,6 +350,8 @@ pte_osResult pte_osThreadExitAndDelete(pte_osThreadHandle handle)
   /* Free the TLS data structure */
   pteTlsThreadDestroy(pTls);
 
+  PTE_STAT_ADD(PTE_STAT_OS_THREADS, -1);
+
   /* Send thread handle to garbage collector task so it can free
    * resources from a different context */
   MBX_post(gcMailbox, &handle, SYS_FOREVER);
@@ -385,6 +390,8 @@ pte_osResult pte_osThreadDelete(pte_osThreadHandle handle)
 
   TSK_delete(handle);
 
+  PTE_STAT_ADD(PTE_STAT_OS_THREADS, -1);
+
   return PTE_OS_OK;
 }
 
@@ -542,6 +549,18 @@ int pte_osThreadGetDefaultPriority()
   return ((TSK_MINPRI + TSK_MAXPRI) / 2);
 }
 
+pte_osResult pte_osThreadRotateReadyQueue(int priority)
+{
+  /* TSK_yield() only rotates the caller's own priority level. */
+  return PTE_OS_GENERAL_FAILURE;
+}
+
+pte_osResult pte_osThreadGetCpuTime(pte_osThreadHandle threadHandle, unsigned long long *pMicroseconds)
+{
+  /* DSP/BIOS keeps no per task CPU time. */
+  return PTE_OS_GENERAL_FAILURE;
+}
+
 /****************************************************************************
  *
  * Mutexes
@@ -559,6 +578,8 @@ pte_osResult pte_osMutexCreate(pte_osMutexHandle *pHandle)
     }
   else
     {
+      PTE_STAT_ADD(PTE_STAT_OS_MUTEXES, 1);
+      PTE_STAT_ADD(PTE_STAT_OS_MUTEXES_CREATED, 1);
       return PTE_OS_OK;
     }
 }
@@ -567,6 +588,8 @@ pte_osResult pte_osMutexDelete(pte_osMutexHandle handle)
 {
   LCK_delete(handle);
 
+  PTE_STAT_ADD(PTE_STAT_OS_MUTEXES, -1);
+
   return PTE_OS_OK;
 }
 
@@ -593,6 +616,16 @@ pte_osResult pte_osMutexUnlock(pte_osMutexHandle handle)
 
 pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHandle)
 {
+  return pte_osSemaphoreCreateEx(initialValue, 0, pHandle);
+}
+
+pte_osResult pte_osSemaphoreCreateEx(int initialValue, int flags, pte_osSemaphoreHandle *pHandle)
+{
+  /* SEM objects always queue their waiters in FIFO order. */
+  if (flags & PTE_OS_SEMAPHORE_PRIORITY)
+    {
+      return PTE_OS_GENERAL_FAILURE;
+    }
 
   *pHandle = SEM_create(initialValue, NULL);
 
@@ -602,6 +635,8 @@ pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHan
     }
   else
     {
+      PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES, 1);
+      PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES_CREATED, 1);
       return PTE_OS_OK;
     }
 
@@ -611,6 +646,8 @@ pte_osResult pte_osSemaphoreDelete(pte_osSemaphoreHandle handle)
 {
   SEM_delete(handle);
 
+  PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES, -1);
+
   return PTE_OS_OK;
 }
 
@@ -895,17 +932,38 @@ void * pte_osTlsGetValue(unsigned int index)
 // Note that key value must be > 0
 pte_osResult pte_osTlsAlloc(unsigned int *pKey)
 {
-  return pteTlsAlloc(pKey);
+  pte_osResult result = pteTlsAlloc(pKey);
+
+  if (result == PTE_OS_OK)
+    {
+      PTE_STAT_ADD(PTE_STAT_OS_TLS_KEYS, 1);
+    }
+
+  return result;
 }
 
 
 pte_osResult pte_osTlsFree(unsigned int index)
 {
+  PTE_STAT_ADD(PTE_STAT_OS_TLS_KEYS, -1);
+
   return pteTlsFree(index);
 
 }
 
 
+unsigned long long pte_osClockGetNanoseconds(void)
+{
+  /* High resolution time is counted in CPU cycles / CLK_cpuCyclesPerHtime() */
+  unsigned long long cycles = (unsigned long long) CLK_gethtime() * CLK_cpuCyclesPerHtime();
+  unsigned long long khz = GBL_getFrequency();
+
+  /* Whole milliseconds first, so that scaling to nanoseconds cannot
+   * overflow (cycles * 1000000 would after a few hours at 1 GHz). */
+  return (cycles / khz) * 1000000ULL + ((cycles % khz) * 1000000ULL) / khz;
+}
+
+
 int ftime(struct timeb *tp)
 {
   int ltime = (CLK_getltime() * CLK_cpuCyclesPerLtime()) / CLK_cpuCyclesPerLtime();
@@ -81,6 +81,15 @@ static void *globalTls;
 static pspThreadData *getThreadData(SceUID threadHandle);
 static void *getTlsStructFromThread(SceUID thid);
 
+/* The PSP kernel treats a lower number as more urgent, while pthreads
+ * expects a higher number to be more urgent.  Map between the two scales
+ * across [pte_osThreadGetMinPriority(), pte_osThreadGetMaxPriority()].
+ */
+static inline int invert_priority(int priority)
+{
+  return (pte_osThreadGetMinPriority() - priority) + pte_osThreadGetMaxPriority();
+}
+
 /* A new thread's stub entry point.  It retrieves the real entry point from the per thread control
  * data as well as any parameters to this function, and then calls the entry point.
  */
@@ -243,7 +252,7 @@ pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
   //  printf("%s %p %d %d %d\n",threadName, pspStubThreadEntry, initialPriority, stackSize, pspAttr);
   threadId = sceKernelCreateThread(threadName,
                                    pspStubThreadEntry,
-                                   initialPriority,
+                                   invert_priority(initialPriority),
                                    stackSize,
                                    pspAttr,
                                    NULL);
@@ -266,6 +275,8 @@ pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
     }
   else
     {
+      PTE_STAT_ADD(PTE_STAT_OS_THREADS, 1);
+      PTE_STAT_ADD(PTE_STAT_OS_THREADS_CREATED, 1);
       *ppte_osThreadHandle = threadId;
       result = PTE_OS_OK;
     }
@@ -300,6 +311,8 @@ pte_osResult pte_osThreadDelete(pte_osThreadHandle handle)
 
   sceKernelDeleteThread(handle);
 
+  PTE_STAT_ADD(PTE_STAT_OS_THREADS, -1);
+
   return PTE_OS_OK;
 }
 
@@ -394,12 +407,12 @@ int pte_osThreadGetPriority(pte_osThreadHandle threadHandle)
 
   sceKernelReferThreadStatus(threadHandle, &thinfo);
 
-  return thinfo.currentPriority;
+  return invert_priority(thinfo.currentPriority);
 }
 
 pte_osResult pte_osThreadSetPriority(pte_osThreadHandle threadHandle, int newPriority)
 {
-  sceKernelChangeThreadPriority(threadHandle, newPriority);
+  sceKernelChangeThreadPriority(threadHandle, invert_priority(newPriority));
   return PTE_OS_OK;
 }
 
@@ -482,7 +495,35 @@ int pte_osThreadGetMaxPriority()
 
 int pte_osThreadGetDefaultPriority()
 {
-  return 18;
+  /* Kernel priority 18, one step less urgent than the most urgent
+   * user priority. */
+  return invert_priority(18);
+}
+
+pte_osResult pte_osThreadRotateReadyQueue(int priority)
+{
+  if (sceKernelRotateThreadReadyQueue(invert_priority(priority)) < 0)
+    {
+      return PTE_OS_GENERAL_FAILURE;
+    }
+
+  return PTE_OS_OK;
+}
+
+pte_osResult pte_osThreadGetCpuTime(pte_osThreadHandle threadHandle, unsigned long long *pMicroseconds)
+{
+  SceKernelThreadInfo thinfo;
+
+  thinfo.size = sizeof(SceKernelThreadInfo);
+
+  if (sceKernelReferThreadStatus(threadHandle, &thinfo) < 0)
+    {
+      return PTE_OS_GENERAL_FAILURE;
+    }
+
+  *pMicroseconds = ((unsigned long long) thinfo.runClocks.hi << 32) | thinfo.runClocks.low;
+
+  return PTE_OS_OK;
 }
 
 int pte_osThreadGetAffinity(pte_osThreadHandle threadHandle)
@@ -521,6 +562,9 @@ pte_osResult pte_osMutexCreate(pte_osMutexHandle *pHandle)
                                1,          /* maximum value        */
                                0);         /* options (default)    */
 
+  PTE_STAT_ADD(PTE_STAT_OS_MUTEXES, 1);
+  PTE_STAT_ADD(PTE_STAT_OS_MUTEXES_CREATED, 1);
+
   *pHandle = handle;
 
   return PTE_OS_OK;
@@ -530,6 +574,8 @@ pte_osResult pte_osMutexDelete(pte_osMutexHandle handle)
 {
   sceKernelDeleteSema(handle);
 
+  PTE_STAT_ADD(PTE_STAT_OS_MUTEXES, -1);
+
   return PTE_OS_OK;
 }
 
@@ -576,7 +622,15 @@ pte_osResult pte_osMutexUnlock(pte_osMutexHandle handle)
  *
  ***************************************************************************/
 
+/* Wake semaphore waiters in thread priority order (default is FIFO) */
+#define PSP_SEMA_ATTR_PRIORITY 0x100
+
 pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHandle)
+{
+  return pte_osSemaphoreCreateEx(initialValue, 0, pHandle);
+}
+
+pte_osResult pte_osSemaphoreCreateEx(int initialValue, int flags, pte_osSemaphoreHandle *pHandle)
 {
   pte_osSemaphoreHandle handle;
   static int semCtr = 0;
@@ -590,11 +644,15 @@ pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHan
   snprintf(semName,sizeof(semName),"pthread_sem%d",semCtr);
 
   handle = sceKernelCreateSema(semName,
-                               0,              /* attributes (default) */
+                               (flags & PTE_OS_SEMAPHORE_PRIORITY) ?
+                               PSP_SEMA_ATTR_PRIORITY : 0, /* attributes */
                                initialValue,   /* initial value        */
                                SEM_VALUE_MAX,  /* maximum value        */
                                0);             /* options (default)    */
 
+  PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES, 1);
+  PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES_CREATED, 1);
+
   *pHandle = handle;
 
   return PTE_OS_OK;
@@ -604,6 +662,8 @@ pte_osResult pte_osSemaphoreDelete(pte_osSemaphoreHandle handle)
 {
   sceKernelDeleteSema(handle);
 
+  PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES, -1);
+
   return PTE_OS_OK;
 }
 
@@ -902,17 +962,40 @@ pte_osResult pte_osTlsAlloc(unsigned int *pKey)
 {
   void * pTls;
 
+  pte_osResult result;
+
   pTls = getTlsStructFromThread(sceKernelGetThreadId());
 
-  return pteTlsAlloc(pKey);
+  result = pteTlsAlloc(pKey);
+
+  if (result == PTE_OS_OK)
+    {
+      PTE_STAT_ADD(PTE_STAT_OS_TLS_KEYS, 1);
+    }
+
+  return result;
 
 }
 
 pte_osResult pte_osTlsFree(unsigned int index)
 {
+  PTE_STAT_ADD(PTE_STAT_OS_TLS_KEYS, -1);
+
   return pteTlsFree(index);
 }
 
+/****************************************************************************
+ *
+ * Clock
+ *
+ ***************************************************************************/
+
+unsigned long long pte_osClockGetNanoseconds(void)
+{
+  /* System time is a monotonic microsecond counter */
+  return (unsigned long long) sceKernelGetSystemTimeWide() * 1000ULL;
+}
+
 /****************************************************************************
  *
  * Miscellaneous
@@ -238,6 +238,8 @@ pte_osResult pte_osThreadCreate(pte_osThreadEntryPoint entryPoint,
 	thread_list[index].evid = sceKernelCreateEventFlag("", 0, 0, NULL);
 
 	sceKernelUnlockLwMutex(&_tls_mutex, 1);
+	PTE_STAT_ADD(PTE_STAT_OS_THREADS, 1);
+	PTE_STAT_ADD(PTE_STAT_OS_THREADS_CREATED, 1);
 	*ppte_osThreadHandle = thid;
 	return PTE_OS_OK;
 }
@@ -261,6 +263,7 @@ pte_osResult pte_osThreadDelete(pte_osThreadHandle handle)
 	sceKernelUnlockLwMutex(&_tls_mutex, 1);
 
 	sceKernelDeleteThread(handle);
+	PTE_STAT_ADD(PTE_STAT_OS_THREADS, -1);
 	return PTE_OS_OK;
 }
 
@@ -377,6 +380,26 @@ int pte_osThreadGetDefaultPriority()
 	return 160;
 }
 
+pte_osResult pte_osThreadRotateReadyQueue(int priority)
+{
+	/* No user mode call rotates another priority's ready queue. */
+	return PTE_OS_GENERAL_FAILURE;
+}
+
+pte_osResult pte_osThreadGetCpuTime(pte_osThreadHandle threadHandle, unsigned long long *pMicroseconds)
+{
+	SceKernelThreadInfo thinfo;
+	thinfo.size = sizeof(SceKernelThreadInfo);
+
+	if (sceKernelGetThreadInfo(threadHandle, &thinfo) < 0)
+	{
+		return PTE_OS_GENERAL_FAILURE;
+	}
+
+	*pMicroseconds = (unsigned long long) thinfo.runClocks;
+	return PTE_OS_OK;
+}
+
 int pte_osThreadGetAffinity(pte_osThreadHandle threadHandle)
 {
 	int affinity = sceKernelGetThreadCpuAffinityMask(threadHandle);
@@ -411,6 +434,8 @@ pte_osResult pte_osMutexCreate(pte_osMutexHandle *pHandle)
 	if (muid < 0)
 		return PTE_OS_GENERAL_FAILURE;
 
+	PTE_STAT_ADD(PTE_STAT_OS_MUTEXES, 1);
+	PTE_STAT_ADD(PTE_STAT_OS_MUTEXES_CREATED, 1);
 	*pHandle = muid;
 	return PTE_OS_OK;
 }
@@ -418,6 +443,7 @@ pte_osResult pte_osMutexCreate(pte_osMutexHandle *pHandle)
 pte_osResult pte_osMutexDelete(pte_osMutexHandle handle)
 {
 	sceKernelDeleteMutex(handle);
+	PTE_STAT_ADD(PTE_STAT_OS_MUTEXES, -1);
 	return PTE_OS_OK;
 }
 
@@ -457,10 +483,19 @@ pte_osResult pte_osMutexUnlock(pte_osMutexHandle handle)
  *
  ***************************************************************************/
 
+/* SCE_KERNEL_ATTR_TH_PRIO: wake waiters in thread priority order */
+#define VITA_SEMA_ATTR_TH_PRIO 0x00002000
+
 pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHandle)
+{
+	return pte_osSemaphoreCreateEx(initialValue, 0, pHandle);
+}
+
+pte_osResult pte_osSemaphoreCreateEx(int initialValue, int flags, pte_osSemaphoreHandle *pHandle)
 {
 	SceUID handle = sceKernelCreateSema("",
-									   0,              /* attributes (default) */
+									   (flags & PTE_OS_SEMAPHORE_PRIORITY) ?
+									   VITA_SEMA_ATTR_TH_PRIO : 0, /* attributes */
 									   initialValue,   /* initial value        */
 									   SEM_VALUE_MAX,  /* maximum value        */
 									   0);             /* options (default)    */
@@ -468,6 +503,8 @@ pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHan
 	if (handle < 0)
 		return PTE_OS_GENERAL_FAILURE;
 
+	PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES, 1);
+	PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES_CREATED, 1);
 	*pHandle = handle;
 	return PTE_OS_OK;
 }
@@ -475,6 +512,7 @@ pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHan
 pte_osResult pte_osSemaphoreDelete(pte_osSemaphoreHandle handle)
 {
 	sceKernelDeleteSema(handle);
+	PTE_STAT_ADD(PTE_STAT_OS_SEMAPHORES, -1);
 	return PTE_OS_OK;
 }
 
@@ -624,15 +662,29 @@ pte_osResult pte_osTlsAlloc(unsigned int *pKey)
 		return PTE_OS_NO_RESOURCES; // no more TLS slots available
 	}
 	*pKey = _last_tls_key++;
+	PTE_STAT_ADD(PTE_STAT_OS_TLS_KEYS, 1);
 	return PTE_OS_OK;
 }
 
 pte_osResult pte_osTlsFree(unsigned int index)
 {
 	// We should have enough slots. Don't worry about this for now
+	PTE_STAT_ADD(PTE_STAT_OS_TLS_KEYS, -1);
 	return PTE_OS_OK;
 }
 
+/****************************************************************************
+ *
+ * Clock
+ *
+ ***************************************************************************/
+
+unsigned long long pte_osClockGetNanoseconds(void)
+{
+	/* Process time is a monotonic microsecond counter */
+	return (unsigned long long) sceKernelGetProcessTimeWide() * 1000ULL;
+}
+
 /****************************************************************************
  *
  * Miscellaneous
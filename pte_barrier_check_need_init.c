@@ -0,0 +1,73 @@
+/*
+ * pte_barrier_check_need_init.c
+ *
+ * Description:
+ * This translation unit implements barrier primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pte_barrier_check_need_init (pthread_barrier_t * barrier)
+{
+  int result;
+  pthread_barrier_t initializer = *barrier;
+  pthread_barrier_t b;
+
+  /*
+   * Barriers declared with PTHREAD_BARRIER_INITIALIZER_NP() are
+   * created lock-free in the same way as static semaphores, see
+   * pte_sem_check_need_init.c.
+   */
+
+  PTE_STAT_ADD (PTE_STAT_BARRIER_LAZY_INITS, 1);
+
+  if (!PTE_IS_COUNT_INITIALIZER (initializer))
+    {
+      return (initializer == NULL ? EINVAL : 0);
+    }
+
+  result = pthread_barrier_init (&b, NULL,
+                                 PTE_COUNT_INITIALIZER_VALUE (initializer));
+
+  if (result != 0)
+    {
+      return result;
+    }
+
+  if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR (barrier, b, initializer) != initializer)
+    {
+      (void) pthread_barrier_destroy (&b);
+
+      if (*barrier == NULL)
+        {
+          return EINVAL;
+        }
+    }
+
+  return 0;
+}
@@ -73,6 +73,8 @@ pte_cond_check_need_init (pthread_cond_t * cond)
    */
 
 
+  PTE_STAT_ADD (PTE_STAT_COND_LAZY_INITS, 1);
+
   pte_osMutexLock (pte_cond_test_init_lock);
 
   /*
@@ -241,7 +241,8 @@ hidden pte_osResult pte_osThreadCheckCancel(pte_osThreadHandle threadHandle);
 hidden void pte_osThreadSleep(unsigned int msecs);
 
 /**
- * Returns the maximum allowable priority
+ * Returns the maximum allowable priority.  Higher values are more urgent;
+ * a port whose kernel counts the other way must invert its priorities.
  */
 hidden int pte_osThreadGetMaxPriority();
 
@@ -256,6 +257,27 @@ hidden int pte_osThreadGetMinPriority();
  */
 hidden int pte_osThreadGetDefaultPriority();
 
+/**
+ * Moves the thread at the head of the ready queue for @p priority to its
+ * tail, so that threads of equal priority share the CPU. Used to time
+ * slice SCHED_RR threads.
+ *
+ * @return PTE_OS_OK - Ready queue rotated.
+ * @return PTE_OS_GENERAL_FAILURE - The OS cannot rotate its ready queues.
+ */
+hidden pte_osResult pte_osThreadRotateReadyQueue(int priority);
+
+/**
+ * Returns the CPU time consumed so far by the specified thread.
+ *
+ * @param threadHandle handle of the thread to query.
+ * @param pMicroseconds set to the CPU time used, in microseconds.
+ *
+ * @return PTE_OS_OK - CPU time returned.
+ * @return PTE_OS_GENERAL_FAILURE - The OS does not account CPU time per thread.
+ */
+hidden pte_osResult pte_osThreadGetCpuTime(pte_osThreadHandle threadHandle, unsigned long long *pMicroseconds);
+
 //@}
 
 
@@ -273,6 +295,22 @@ hidden int pte_osThreadGetDefaultPriority();
  */
 hidden pte_osResult pte_osSemaphoreCreate(int initialValue, pte_osSemaphoreHandle *pHandle);
 
+/** Release waiters highest priority first, rather than in an OS chosen order. */
+#define PTE_OS_SEMAPHORE_PRIORITY 1
+
+/**
+ * Creates a semaphore with non-default attributes.
+ *
+ * @param initialValue Initial value of the semaphore
+ * @param flags    Zero, or PTE_OS_SEMAPHORE_PRIORITY.
+ * @param pHandle  Set to the handle of the newly created semaphore.
+ *
+ * @return PTE_OS_OK - Semaphore successfully created
+ * @return PTE_OS_NO_RESOURCES - Insufficient resources to create semaphore
+ * @return PTE_OS_GENERAL_FAILURE - The OS does not support the requested flags
+ */
+hidden pte_osResult pte_osSemaphoreCreateEx(int initialValue, int flags, pte_osSemaphoreHandle *pHandle);
+
 /**
  * Deletes a semaphore and frees any associated resources.
  *
@@ -452,6 +490,81 @@ hidden int pte_osAtomicDecrement(int *pdest);
 hidden int pte_osAtomicIncrement(int *pdest);
 //@}
 
+/** @name Clock */
+//@{
+
+/**
+ * Returns a monotonically increasing timestamp in nanoseconds, measured from
+ * an arbitrary fixed point.  The value is scaled from the finest counter the
+ * OS offers, so successive readings may advance in steps much larger than one
+ * nanosecond.  Timeouts are computed from this clock too, so it is read on
+ * every timed wait: use the cheapest counter the OS has, ideally one
+ * readable without a system call.
+ *
+ * @return Current timestamp in nanoseconds.
+ */
+hidden unsigned long long pte_osClockGetNanoseconds(void);
+//@}
+
+/** @name Statistics */
+//@{
+
+/**
+ * Counters reported by pthread_getstats_np().  They are shared by the core
+ * library and the OSAL, so an OSAL bumps the PTE_STAT_OS_* entries from its
+ * create/delete routines with PTE_STAT_ADD().  Entries before
+ * PTE_STAT_FIRST_COUNTER are gauges (current values); the rest are totals
+ * cleared by pthread_resetstats_np().
+ *
+ * Only compiled in when PTE_STATS is defined; otherwise PTE_STAT_ADD()
+ * expands to nothing.
+ */
+#ifdef PTE_STATS
+enum
+{
+  PTE_STAT_OS_SEMAPHORES,
+  PTE_STAT_OS_MUTEXES,
+  PTE_STAT_OS_THREADS,
+  PTE_STAT_OS_TLS_KEYS,
+  PTE_STAT_REUSE_DEPTH,
+
+  PTE_STAT_OS_SEMAPHORES_CREATED,
+  PTE_STAT_OS_MUTEXES_CREATED,
+  PTE_STAT_OS_THREADS_CREATED,
+  PTE_STAT_THREADS_REUSED,
+  PTE_STAT_MUTEX_LAZY_INITS,
+  PTE_STAT_COND_LAZY_INITS,
+  PTE_STAT_RWLOCK_LAZY_INITS,
+  PTE_STAT_SPIN_LAZY_INITS,
+  PTE_STAT_SEM_LAZY_INITS,
+  PTE_STAT_BARRIER_LAZY_INITS,
+
+  PTE_STAT_COUNT
+};
+
+#define PTE_STAT_FIRST_COUNTER PTE_STAT_OS_SEMAPHORES_CREATED
+
+extern hidden int pte_stats[PTE_STAT_COUNT];
+
+/*
+ * Statistics need no ordering with respect to anything else, so use a
+ * relaxed add where the compiler offers one.
+ */
+#ifdef __GNUC__
+#define PTE_STAT_ADD(stat, n) \
+  ((void) __atomic_fetch_add (&pte_stats[(stat)], (n), __ATOMIC_RELAXED))
+#else
+#define PTE_STAT_ADD(stat, n) \
+  ((void) pte_osAtomicExchangeAdd (&pte_stats[(stat)], (n)))
+#endif
+
+#else
+
+#define PTE_STAT_ADD(stat, n)
+
+#endif /* PTE_STATS */
+//@}
+
 struct timeb;
 
 int ftime(struct timeb *tb);
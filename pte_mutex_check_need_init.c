@@ -86,6 +86,8 @@ pte_mutex_check_need_init (pthread_mutex_t * mutex)
    */
 
 
+  PTE_STAT_ADD (PTE_STAT_MUTEX_LAZY_INITS, 1);
+
   pte_osMutexLock (pte_mutex_test_init_lock);
 
   /*
@@ -0,0 +1,69 @@
+/*
+ * pte_mutex_next_in_order.c
+ *
+ * Description:
+ * This translation unit implements mutual exclusion (mutex) primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pte_mutex_next_in_order (pthread_mutex_t * const * mutexes, int count, int prev)
+/*
+ * ------------------------------------------------------
+ * DESCRIPTION
+ *      Returns the index into 'mutexes' of the initialised mutex
+ *      with the lowest address that is strictly greater than that
+ *      of mutexes[prev], or the lowest overall if 'prev' is negative.
+ *      Returns -1 when there is no such mutex.
+ *
+ *      Walking the set this way visits every distinct mutex exactly
+ *      once and in a global (address) order without having to copy
+ *      or sort the caller's array. Duplicates are visited once.
+ *
+ *      The sets passed to pthread_mutex_lock_many_np() are expected
+ *      to be small, so the quadratic walk is cheaper than sorting.
+ * ------------------------------------------------------
+ */
+{
+  int i;
+  int next = -1;
+  pthread_mutex_t floor = (prev < 0 ? NULL : *mutexes[prev]);
+
+  for (i = 0; i < count; i++)
+    {
+      pthread_mutex_t mx = *mutexes[i];
+
+      if ((floor == NULL || mx > floor) &&
+          (next < 0 || mx < *mutexes[next]))
+        {
+          next = i;
+        }
+    }
+
+  return next;
+}
@@ -77,10 +77,20 @@ pte_new (void)
 
       /* ptHandle.p needs to point to it's parent pte_thread_t. */
       t = tp->ptHandle = (pthread_t)tp;
+
+      /*
+       * pte_thread_t structs are never freed; keep them all on one
+       * list so pthread_dump_waits_np() can find every thread.
+       */
+      pte_osMutexLock (pte_thread_reuse_lock);
+      tp->nextThread = pte_threadList;
+      pte_threadList = tp;
+      pte_osMutexUnlock (pte_thread_reuse_lock);
     }
 
   /* Set default state. */
   tp->sched_priority = pte_osThreadGetMinPriority();
+  tp->sched_policy = SCHED_OTHER;
 
   tp->detachState = PTHREAD_CREATE_JOINABLE;
   tp->cancelState = PTHREAD_CANCEL_ENABLE;
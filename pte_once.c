@@ -0,0 +1,188 @@
+/*
+ * pte_once.c
+ *
+ * Description:
+ * This translation unit implements miscellaneous thread functions.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pte_osal.h"
+#include "pthread.h"
+#include "implement.h"
+
+#define PTE_ONCE_STARTED 1
+#define PTE_ONCE_INIT 0
+#define PTE_ONCE_DONE 2
+
+static void
+pte_once_init_routine_cleanup(void * arg)
+{
+  pthread_once_t * once_control = (pthread_once_t *) arg;
+
+  (void) PTE_ATOMIC_EXCHANGE(&once_control->state,PTE_ONCE_INIT);
+
+  if (PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
+    {
+      pte_osSemaphorePost((pte_osSemaphoreHandle) once_control->semaphore, 1);
+    }
+}
+
+/*
+ * Drops a waiter's use of the semaphore, deleting it if it was the
+ * last. Also run if a cancellable wait is cancelled.
+ */
+static void
+pte_once_wait_cleanup(void * arg)
+{
+  pthread_once_t * once_control = (pthread_once_t *) arg;
+  pte_osSemaphoreHandle sema;
+
+  if (0 == PTE_ATOMIC_DECREMENT(&once_control->numSemaphoreUsers))
+    {
+      /* we were last */
+      if ((sema =
+             (pte_osSemaphoreHandle) PTE_ATOMIC_EXCHANGE((int *) &once_control->semaphore,0)))
+        {
+          pte_osSemaphoreDelete(sema);
+        }
+    }
+}
+
+/*
+ * Common code of pthread_once() and its _np variants. Exactly one of
+ * 'init_routine' and 'init_result' is given; the value returned by
+ * 'init_result' is kept in the control and returned to every caller,
+ * so a failed initialisation is reported rather than retried. Waiting
+ * for another thread's initialisation ends at 'abstime' if it is not
+ * NULL, and is a cancellation point if 'cancellable' is set.
+ *
+ * Once initialisation has completed, returning its result takes one
+ * acquire load.
+ */
+int
+pte_once (pthread_once_t * once_control, void (*init_routine) (void),
+          int (*init_result) (void), const struct timespec * abstime,
+          int cancellable)
+{
+  int result;
+  int state;
+  unsigned int milliseconds;
+  pte_osSemaphoreHandle sema;
+
+  if (PTE_ATOMIC_LOAD_ACQUIRE(&once_control->state) == PTE_ONCE_DONE)
+    {
+      return once_control->result;
+    }
+
+  while ((state =
+            PTE_ATOMIC_COMPARE_EXCHANGE(&once_control->state,
+                                        PTE_ONCE_STARTED,
+                                        PTE_ONCE_INIT))
+         != PTE_ONCE_DONE)
+    {
+      if (PTE_ONCE_INIT == state)
+        {
+          result = 0;
+
+          pthread_cleanup_push(pte_once_init_routine_cleanup, (void *) once_control);
+
+          if (init_routine != NULL)
+            {
+              (*init_routine)();
+            }
+          else
+            {
+              result = (*init_result)();
+            }
+
+          pthread_cleanup_pop(0);
+
+          /* Published by the exchange below. */
+          once_control->result = result;
+
+          (void) PTE_ATOMIC_EXCHANGE(&once_control->state,PTE_ONCE_DONE);
+
+          /*
+           * we didn't create the semaphore.
+           * it is only there if there is someone waiting.
+           */
+          if (PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
+            {
+              pte_osSemaphorePost((pte_osSemaphoreHandle) once_control->semaphore,once_control->numSemaphoreUsers);
+            }
+        }
+      else
+        {
+          result = 0;
+
+          PTE_ATOMIC_INCREMENT(&once_control->numSemaphoreUsers);
+
+          if (!PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
+            {
+              pte_osSemaphoreCreate(0, (pte_osSemaphoreHandle*) &sema);
+
+              if (PTE_ATOMIC_COMPARE_EXCHANGE((int *) &once_control->semaphore,
+                                              (int) sema,
+                                              0))
+                {
+                  pte_osSemaphoreDelete((pte_osSemaphoreHandle)sema);
+                }
+            }
+
+          pthread_cleanup_push(pte_once_wait_cleanup, (void *) once_control);
+
+          /*
+           * Check 'state' again in case the initting thread has finished or
+           * cancelled and left before seeing that there was a semaphore.
+           */
+          if (PTE_ATOMIC_EXCHANGE_ADD(&once_control->state, 0L) == PTE_ONCE_STARTED)
+            {
+              if (abstime != NULL)
+                {
+                  milliseconds = pte_relmillisecs (abstime);
+                }
+
+              if (cancellable)
+                {
+                  result = pte_cancellable_wait((pte_osSemaphoreHandle) once_control->semaphore,
+                                                abstime != NULL ? &milliseconds : NULL);
+                }
+              else if (pte_osSemaphorePend((pte_osSemaphoreHandle) once_control->semaphore,
+                                           abstime != NULL ? &milliseconds : NULL) == PTE_OS_TIMEOUT)
+                {
+                  result = ETIMEDOUT;
+                }
+            }
+
+          pthread_cleanup_pop(1);
+
+          if (result != 0)
+            {
+              return result;
+            }
+        }
+    }
+
+  return once_control->result;
+}
@@ -0,0 +1,129 @@
+/*
+ * pte_park.c
+ *
+ * Description:
+ * Parking a thread on its own semaphore.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+/*
+ * Objects that keep their own queue of waiting threads (barriers, rwlocks)
+ * block each waiter on a semaphore owned by the waiting thread,
+ * rather than on one shared by every waiter of the object. A wakeup
+ * then always reaches the thread it was meant for.
+ *
+ * The semaphore is created the first time a thread struct parks, and
+ * is kept when the struct is reused, as pte_thread_t structs are
+ * never freed. A waker may therefore still post to it after the
+ * thread it woke has exited. Such a late post is harmless: pte_park()
+ * only returns once parkWoken is set, and consumes stray posts.
+ */
+
+/*
+ * Prepares 'self' to park. Must be called before 'self' is made
+ * visible to the thread that will call pte_unpark().
+ */
+int
+pte_parkPrepare (pte_thread_t * self)
+{
+  if (!self->parkSemCreated)
+    {
+      if (pte_osSemaphoreCreate (0, &self->parkSem) != PTE_OS_OK)
+        {
+          return EAGAIN;
+        }
+
+      self->parkSemCreated = PTE_TRUE;
+    }
+
+  self->parkWoken = 0;
+
+  return 0;
+}
+
+/*
+ * Blocks until pte_unpark(self) is called.
+ */
+void
+pte_park (pte_thread_t * self)
+{
+  while (!self->parkWoken)
+    {
+      (void) pte_osSemaphorePend (self->parkSem, NULL);
+    }
+}
+
+/*
+ * As pte_park(), giving up after *pTimeout milliseconds. Returns 0
+ * if woken, else ETIMEDOUT. A thread that times out must still find
+ * out, under the lock its waker takes, whether it was woken after all.
+ *
+ * The timeout is one deadline on the OSAL clock: a pend that returns
+ * without a wakeup is repeated only for the time still left, so stray
+ * posts cannot stretch the wait.
+ */
+int
+pte_parkTimed (pte_thread_t * self, const unsigned int * pTimeout)
+{
+  const unsigned long long NANOSEC_PER_MILLISEC = 1000000;
+  unsigned long long deadline;
+  unsigned long long now;
+  unsigned int milliseconds = *pTimeout;
+
+  deadline = pte_osClockGetNanoseconds ()
+             + (unsigned long long) milliseconds * NANOSEC_PER_MILLISEC;
+
+  while (!self->parkWoken)
+    {
+      if (pte_osSemaphorePend (self->parkSem, &milliseconds) == PTE_OS_TIMEOUT)
+        {
+          return self->parkWoken ? 0 : ETIMEDOUT;
+        }
+
+      now = pte_osClockGetNanoseconds ();
+
+      if (now >= deadline)
+        {
+          /* Last chance to see a wakeup that raced the deadline. */
+          milliseconds = 0;
+        }
+      else
+        {
+          milliseconds = (unsigned int) ((deadline - now + NANOSEC_PER_MILLISEC - 1)
+                                         / NANOSEC_PER_MILLISEC);
+        }
+    }
+
+  return 0;
+}
+
+void
+pte_unpark (pte_thread_t * tp)
+{
+  (void) PTE_ATOMIC_EXCHANGE ((int *) &tp->parkWoken, 1);
+  (void) pte_osSemaphorePost (tp->parkSem, 1);
+}
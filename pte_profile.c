@@ -0,0 +1,120 @@
+/*
+ * pte_profile.c
+ *
+ * Description:
+ * Samples contended mutex and rwlock locks by call site, see pthread_profile_enable_np().
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+/*
+ * Samples go into a fixed open-addressed hash table keyed by the
+ * return address of the lock call. A slot is claimed with a compare
+ * and exchange on its state; a thread that finds a slot still being
+ * claimed moves on rather than wait for it, so the same site can
+ * rarely occupy two slots - pthread_profile_top_np() merges them.
+ * When the table is full the sample is only counted as dropped.
+ *
+ * pte_profileActive counts the samplers inside pte_profileSample(),
+ * so that pthread_profile_enable_np() can wait for stragglers from a
+ * previous run before it clears the table.
+ */
+static unsigned int
+pte_profileHash (void * site)
+{
+  /* Fibonacci hashing; the low bits of a return address vary least. */
+  return (unsigned int) (((unsigned long) site >> 2) * 2654435761u);
+}
+
+
+void
+pte_profileSample (pte_thread_t * waiter, void * site)
+/*
+ * ------------------------------------------------------
+ * DESCRIPTION
+ *      Adds the wait that 'waiter' has just finished to the
+ *      entry for 'site'. The wait began at waiter->waitStart,
+ *      set by pte_waitBegin().
+ * ------------------------------------------------------
+ */
+{
+  pte_profile_site_t * entry;
+  unsigned long long waited;
+  unsigned int slot;
+  int us, max, total, sum, i;
+
+  waiter->profileTick = 0;
+
+  (void) PTE_ATOMIC_INCREMENT (&pte_profileActive);
+
+  /* Stopped since the caller looked; the table may be being reset. */
+  if (pte_profilePeriod == 0)
+    {
+      (void) PTE_ATOMIC_DECREMENT (&pte_profileActive);
+      return;
+    }
+
+  waited = (pte_osClockGetNanoseconds () - waiter->waitStart) / 1000;
+  us = waited > 0x7fffffff ? 0x7fffffff : (int) waited;
+
+  slot = pte_profileHash (site);
+
+  for (i = 0; i < PTE_PROFILE_SITES; i++)
+    {
+      entry = &pte_profileSites[(slot + i) & (PTE_PROFILE_SITES - 1)];
+
+      if (entry->state == 0 &&
+          PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &entry->state, 1, 0) == 0)
+        {
+          entry->site = site;
+          (void) PTE_ATOMIC_EXCHANGE ((int *) &entry->state, 2);
+        }
+
+      if (entry->state == 2 && entry->site == site)
+        {
+          (void) PTE_ATOMIC_INCREMENT ((int *) &entry->samples);
+
+          /* Saturate rather than wrap: about 36 minutes of waiting fills an int. */
+          do
+            {
+              total = entry->totalWaitUs;
+              sum = total > 0x7fffffff - us ? 0x7fffffff : total + us;
+            }
+          while (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &entry->totalWaitUs, sum, total) != total);
+
+          while ((max = entry->maxWaitUs) < us &&
+                 PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &entry->maxWaitUs, us, max) != max)
+            {
+            }
+
+          (void) PTE_ATOMIC_DECREMENT (&pte_profileActive);
+          return;
+        }
+    }
+
+  (void) PTE_ATOMIC_INCREMENT (&pte_profileDropped);
+  (void) PTE_ATOMIC_DECREMENT (&pte_profileActive);
+}
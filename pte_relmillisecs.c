@@ -45,7 +45,77 @@
 #include "pthread.h"
 #include "implement.h"
 
-typedef long long int64_t;
+/*
+ * Wall clock time is the OSAL monotonic clock plus an offset, taken
+ * from ftime() at most once per PTE_CLOCK_RESYNC_USECS (and again
+ * after pthread_timechange_handler_np()). Timed waits then cost one
+ * clock read instead of a trip through the libc time functions.
+ *
+ * The offset lives in two slots. A resync fills the one not in use
+ * and then publishes it, so readers never see a half written 64 bit
+ * value; a reader would have to stall across two resyncs to do so.
+ */
+typedef struct
+{
+  long long offsetMsecs;
+  unsigned long long syncedUsecs;
+} pte_clock_sync_t;
+
+static pte_clock_sync_t pte_clockSync[2];
+static int pte_clockSyncIndex = -1;	/* Slot in use, or -1 to resync */
+static int pte_clockSyncNext = 0;
+static int pte_clockSyncBusy = 0;
+
+static long long
+pte_clockGetRealMillisecs (void)
+{
+  const long long MILLISEC_PER_SEC = 1000;
+  const unsigned long long MICROSEC_PER_MILLISEC = 1000;
+  const unsigned long long NANOSEC_PER_MICROSEC = 1000;
+  struct timeb currSysTime;
+  unsigned long long now;
+  long long realMsecs;
+  int i;
+
+  now = pte_osClockGetNanoseconds () / NANOSEC_PER_MICROSEC;
+  i = pte_clockSyncIndex;
+
+  if (i >= 0 && now - pte_clockSync[i].syncedUsecs < PTE_CLOCK_RESYNC_USECS)
+    {
+      return (long long) (now / MICROSEC_PER_MILLISEC) + pte_clockSync[i].offsetMsecs;
+    }
+
+  _ftime(&currSysTime);
+
+  realMsecs = (long long) currSysTime.time * MILLISEC_PER_SEC;
+  realMsecs += (long long) currSysTime.millitm;
+
+  /* Whoever loses the race just uses the time it has read. */
+  if (PTE_ATOMIC_COMPARE_EXCHANGE (&pte_clockSyncBusy, 1, 0) == 0)
+    {
+      i = pte_clockSyncNext;
+      pte_clockSyncNext = i ^ 1;
+
+      pte_clockSync[i].offsetMsecs = realMsecs - (long long) (now / MICROSEC_PER_MILLISEC);
+      pte_clockSync[i].syncedUsecs = now;
+
+      (void) PTE_ATOMIC_EXCHANGE (&pte_clockSyncIndex, i);
+      (void) PTE_ATOMIC_EXCHANGE (&pte_clockSyncBusy, 0);
+    }
+
+  return realMsecs;
+}
+
+
+/*
+ * Forces the next timeout computation to read the wall clock again.
+ */
+void
+pte_clockResync (void)
+{
+  (void) PTE_ATOMIC_EXCHANGE (&pte_clockSyncIndex, -1);
+}
+
 
 unsigned int
 pte_relmillisecs (const struct timespec * abstime)
@@ -55,7 +125,6 @@ pte_relmillisecs (const struct timespec * abstime)
   unsigned int milliseconds;
   long long tmpAbsMilliseconds;
   long long tmpCurrMilliseconds;
-  struct timeb currSysTime;
 
   /*
    * Calculate timeout as milliseconds from current system time.
@@ -68,15 +137,12 @@ pte_relmillisecs (const struct timespec * abstime)
    *
    * Assume all integers are unsigned, i.e. cannot test if less than 0.
    */
-  tmpAbsMilliseconds =  (int64_t)abstime->tv_sec * MILLISEC_PER_SEC;
-  tmpAbsMilliseconds += ((int64_t)abstime->tv_nsec + (NANOSEC_PER_MILLISEC/2)) / NANOSEC_PER_MILLISEC;
+  tmpAbsMilliseconds =  (long long)abstime->tv_sec * MILLISEC_PER_SEC;
+  tmpAbsMilliseconds += ((long long)abstime->tv_nsec + (NANOSEC_PER_MILLISEC/2)) / NANOSEC_PER_MILLISEC;
 
   /* get current system time */
 
-  _ftime(&currSysTime);
-
-  tmpCurrMilliseconds = (int64_t) currSysTime.time * MILLISEC_PER_SEC;
-  tmpCurrMilliseconds += (int64_t) currSysTime.millitm;
+  tmpCurrMilliseconds = pte_clockGetRealMillisecs ();
 
   if (tmpAbsMilliseconds > tmpCurrMilliseconds)
     {
@@ -95,3 +161,37 @@ pte_relmillisecs (const struct timespec * abstime)
 
   return milliseconds;
 }
+
+/*
+ * Converts an interval for the *_np relative timeout functions to
+ * the milliseconds the OSAL pends take, rounding up so that a wait
+ * is never shorter than asked for. No clock is read.
+ */
+int
+pte_reltimeout (const struct timespec * reltime, unsigned int * milliseconds)
+{
+  const long long NANOSEC_PER_MILLISEC = 1000000;
+  const long long MILLISEC_PER_SEC = 1000;
+  long long tmpMilliseconds;
+
+  if (reltime == NULL
+      || reltime->tv_sec < 0
+      || reltime->tv_nsec < 0
+      || reltime->tv_nsec >= NANOSEC_PER_MILLISEC * MILLISEC_PER_SEC)
+    {
+      return EINVAL;
+    }
+
+  tmpMilliseconds =  (long long)reltime->tv_sec * MILLISEC_PER_SEC;
+  tmpMilliseconds += ((long long)reltime->tv_nsec + NANOSEC_PER_MILLISEC - 1) / NANOSEC_PER_MILLISEC;
+
+  /* Timeouts must be finite */
+  if (tmpMilliseconds >= 0xFFFFFFFF)
+    {
+      tmpMilliseconds = 0xFFFFFFFE;
+    }
+
+  *milliseconds = (unsigned int) tmpMilliseconds;
+
+  return 0;
+}
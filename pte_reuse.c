@@ -104,6 +104,9 @@ pte_threadReusePop (void)
       tp->prevReuse = NULL;
 
       t = tp->ptHandle;
+
+      PTE_STAT_ADD (PTE_STAT_REUSE_DEPTH, -1);
+      PTE_STAT_ADD (PTE_STAT_THREADS_REUSED, 1);
     }
 
   pte_osMutexUnlock(pte_thread_reuse_lock);
@@ -123,15 +126,27 @@ pte_threadReusePush (pthread_t thread)
 {
   pte_thread_t * tp = (pte_thread_t *) thread;
   pthread_t t = NULL;
+  pte_thread_t * next;
+  pte_osSemaphoreHandle parkSem;
+  int parkSemCreated;
 
 
   pte_osMutexLock (pte_thread_reuse_lock);
 
   t = tp->ptHandle;
+  next = tp->nextThread;
+  parkSem = tp->parkSem;
+  parkSemCreated = tp->parkSemCreated;
   memset(tp, 0, sizeof(pte_thread_t));
 
-  /* Must restore the original POSIX handle that we just wiped. */
+  /*
+   * Must restore the original POSIX handle and list link that we just wiped,
+   * and the park semaphore, which may still be posted to (see pte_park.c).
+   */
   tp->ptHandle = t;
+  tp->nextThread = next;
+  tp->parkSem = parkSem;
+  tp->parkSemCreated = parkSemCreated;
 
   tp->prevReuse = PTE_THREAD_REUSE_EMPTY;
 
@@ -146,5 +161,7 @@ pte_threadReusePush (pthread_t thread)
 
   pte_threadReuseBottom = tp;
 
+  PTE_STAT_ADD (PTE_STAT_REUSE_DEPTH, 1);
+
   pte_osMutexUnlock(pte_thread_reuse_lock);
 }
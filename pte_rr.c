@@ -0,0 +1,156 @@
+/*
+ * pte_rr.c
+ *
+ * Description:
+ * Time slicing of SCHED_RR threads.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+#include "sched.h"
+
+/*
+ * The OS schedules by fixed priority: a thread runs until it blocks or
+ * a higher priority thread becomes ready, which is SCHED_FIFO. For
+ * SCHED_RR a helper OS thread at the highest priority wakes every
+ * PTE_RR_QUANTUM_MSECS and rotates the ready queue of each priority
+ * that has a SCHED_RR thread. Threads of other policies that share
+ * such a priority are rotated along with them; the OS offers no finer
+ * control.
+ *
+ * The helper is started by the first thread to become SCHED_RR, and
+ * only if the OS can rotate its ready queues. Otherwise pte_rrState
+ * records that, and SCHED_RR threads run as SCHED_FIFO.
+ * pthread_terminate() stops it again with pte_rrStop().
+ */
+
+static pte_osThreadHandle pte_rrTickerThread;
+static pte_osSemaphoreHandle pte_rrStopSem;	/* Posted to stop the helper */
+
+static int
+pte_rrTicker (void * arg)
+{
+  int levels[PTE_RR_MAX_LEVELS];
+  int numLevels;
+  int i;
+  unsigned int timeout;
+  pte_thread_t * tp;
+
+  for (;;)
+    {
+      timeout = PTE_RR_QUANTUM_MSECS;
+
+      if (pte_osSemaphorePend (pte_rrStopSem, &timeout) != PTE_OS_TIMEOUT)
+        {
+          break;
+        }
+
+      numLevels = 0;
+
+      /* See pthread_dump_waits_np() on walking the thread list. */
+      pte_osMutexLock (pte_thread_reuse_lock);
+
+      for (tp = pte_threadList; tp != NULL; tp = tp->nextThread)
+        {
+          if (tp->threadId == 0 || tp->sched_policy != SCHED_RR)
+            {
+              continue;
+            }
+
+          for (i = 0; i < numLevels && levels[i] != tp->sched_priority; i++)
+            ;
+
+          if (i == numLevels && numLevels < PTE_RR_MAX_LEVELS)
+            {
+              levels[numLevels++] = tp->sched_priority;
+            }
+        }
+
+      pte_osMutexUnlock (pte_thread_reuse_lock);
+
+      for (i = 0; i < numLevels; i++)
+        {
+          (void) pte_osThreadRotateReadyQueue (levels[i]);
+        }
+    }
+
+  return 0;
+}
+
+/*
+ * Called when a thread becomes SCHED_RR at 'priority'.
+ */
+void
+pte_rrStart (int priority)
+{
+  if (pte_rrState != PTE_RR_IDLE
+      || PTE_ATOMIC_COMPARE_EXCHANGE (&pte_rrState, PTE_RR_STARTING,
+                                      PTE_RR_IDLE) != PTE_RR_IDLE)
+    {
+      return;
+    }
+
+  /*
+   * Rotating the new thread's level once is harmless, and tells us
+   * whether the OS can do it at all.
+   */
+  if (pte_osThreadRotateReadyQueue (priority) != PTE_OS_OK
+      || pte_osSemaphoreCreate (0, &pte_rrStopSem) != PTE_OS_OK)
+    {
+      pte_rrState = PTE_RR_UNSUPPORTED;
+      return;
+    }
+
+  if (pte_osThreadCreate (pte_rrTicker, PTHREAD_STACK_MIN,
+                          pte_osThreadGetMaxPriority (),
+                          NULL, &pte_rrTickerThread) != PTE_OS_OK)
+    {
+      (void) pte_osSemaphoreDelete (pte_rrStopSem);
+      pte_rrState = PTE_RR_UNSUPPORTED;
+      return;
+    }
+
+  pte_rrState = PTE_RR_RUNNING;
+  (void) pte_osThreadStart (pte_rrTickerThread);
+}
+
+/*
+ * Stops the helper, if it was started, and waits for it to end.
+ * Called from pthread_terminate(), once no SCHED_RR thread can be
+ * starting it.
+ */
+void
+pte_rrStop (void)
+{
+  if (pte_rrState == PTE_RR_RUNNING)
+    {
+      (void) pte_osSemaphorePost (pte_rrStopSem, 1);
+      (void) pte_osThreadWaitForEnd (pte_rrTickerThread);
+      (void) pte_osThreadDelete (pte_rrTickerThread);
+      (void) pte_osSemaphoreDelete (pte_rrStopSem);
+    }
+
+  pte_rrState = PTE_RR_IDLE;
+}
@@ -72,6 +72,8 @@ pte_rwlock_check_need_init (pthread_rwlock_t * rwlock)
    */
 
 
+  PTE_STAT_ADD (PTE_STAT_RWLOCK_LAZY_INITS, 1);
+
   pte_osMutexLock (pte_rwlock_test_init_lock);
 
   /*
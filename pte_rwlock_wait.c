@@ -0,0 +1,265 @@
+/*
+ * pte_rwlock_wait.c
+ *
+ * Description:
+ * This translation unit implements read/write lock primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <errno.h>
+
+#include "pthread.h"
+#include "implement.h"
+
+/*
+ * An rwlock is one state word: the number of readers holding it, or
+ * PTE_RWLOCK_WRITER, plus PTE_RWLOCK_WAITERS while threads are queued.
+ * Locking and unlocking without contention is a single atomic on it.
+ *
+ * Threads that must wait park (see pte_park.c) on the rwlock's queue,
+ * in arrival order, guarded by queueLock. PTE_RWLOCK_WAITERS is set
+ * under queueLock before a thread queues. While it is set the fast
+ * paths fail, so a queued writer holds back later readers, and
+ * whoever leaves the lock free dispatches: it hands the lock to the
+ * writer at the head of the queue, or to the readers at its head, by
+ * updating the state on their behalf and unparking them.
+ */
+
+/*
+ * Hands the lock to the head of the queue if it is free.
+ * queueLock is held.
+ */
+static void
+pte_rwlock_dispatch (pthread_rwlock_t rwl)
+{
+  pte_thread_t * head;
+  pte_thread_t * tp;
+  pte_thread_t * next;
+  int s;
+  int n;
+
+  for (;;)
+    {
+      s = rwl->state;
+      head = rwl->waiters;
+
+      if (s & PTE_RWLOCK_WRITER)
+        {
+          /* The writer dispatches when it unlocks. */
+          return;
+        }
+
+      if (head == NULL)
+        {
+          /* Nobody left to wake, e.g. after a timeout. */
+          if (!(s & PTE_RWLOCK_WAITERS)
+              || PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state,
+                                              s & ~PTE_RWLOCK_WAITERS,
+                                              s) == s)
+            {
+              return;
+            }
+
+          continue;
+        }
+
+      if (head->parkExclusive)
+        {
+          if (s & PTE_RWLOCK_READERS)
+            {
+              /* The last reader dispatches when it unlocks. */
+              return;
+            }
+
+          tp = head->parkNext;
+          n = PTE_RWLOCK_WRITER;
+        }
+      else
+        {
+          /* Every reader ahead of the first queued writer. */
+          n = s & PTE_RWLOCK_READERS;
+
+          for (tp = head; tp != NULL && !tp->parkExclusive; tp = tp->parkNext)
+            {
+              n++;
+            }
+        }
+
+      if (tp != NULL)
+        {
+          n |= PTE_RWLOCK_WAITERS;
+        }
+
+      if (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state, n, s) == s)
+        {
+          break;
+        }
+    }
+
+  /* The lock is theirs; let them go. */
+  rwl->waiters = tp;
+
+  for (; head != tp; head = next)
+    {
+      next = head->parkNext;
+      pte_unpark (head);
+    }
+}
+
+
+/*
+ * Called by an unlock that left the lock free with PTE_RWLOCK_WAITERS
+ * set.
+ */
+void
+pte_rwlock_wake (pthread_rwlock_t rwl)
+{
+  pte_osMutexLock (rwl->queueLock);
+  pte_rwlock_dispatch (rwl);
+  pte_osMutexUnlock (rwl->queueLock);
+}
+
+
+/*
+ * Slow path of the lock functions: take the lock or queue for it,
+ * waiting until 'abstime' if it is not NULL. The deadline becomes a
+ * wait budget once, just before parking, and that budget covers the
+ * whole wait.
+ *
+ * RESULTS
+ *              0               the lock is held,
+ *              EAGAIN          too many readers, or no resources to park,
+ *              ETIMEDOUT       the timeout elapsed first.
+ */
+int
+pte_rwlock_wait (pthread_rwlock_t rwl, int writer,
+                 const struct timespec * abstime)
+{
+  pte_thread_t * self;
+  unsigned int milliseconds;
+  pte_thread_t ** link;
+  int result;
+  int s;
+
+  if ((self = (pte_thread_t *) pthread_self ()) == NULL)
+    {
+      return EAGAIN;
+    }
+
+  if ((result = pte_parkPrepare (self)) != 0)
+    {
+      return result;
+    }
+
+  pte_osMutexLock (rwl->queueLock);
+
+  for (;;)
+    {
+      s = rwl->state;
+
+      if (writer)
+        {
+          if ((s & (PTE_RWLOCK_WRITER | PTE_RWLOCK_READERS)) == 0)
+            {
+              if (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state,
+                                               s | PTE_RWLOCK_WRITER, s) == s)
+                {
+                  pte_osMutexUnlock (rwl->queueLock);
+                  return 0;
+                }
+
+              continue;
+            }
+        }
+      else if (!(s & PTE_RWLOCK_WRITER) && rwl->waiters == NULL)
+        {
+          if ((s & PTE_RWLOCK_READERS) == PTE_RWLOCK_READERS)
+            {
+              pte_osMutexUnlock (rwl->queueLock);
+              return EAGAIN;
+            }
+
+          if (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state, s + 1, s) == s)
+            {
+              pte_osMutexUnlock (rwl->queueLock);
+              return 0;
+            }
+
+          continue;
+        }
+
+      if ((s & PTE_RWLOCK_WAITERS)
+          || PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state,
+                                          s | PTE_RWLOCK_WAITERS, s) == s)
+        {
+          break;
+        }
+    }
+
+  for (link = &rwl->waiters; *link != NULL; link = &(*link)->parkNext)
+    ;
+
+  self->parkExclusive = writer;
+  self->parkNext = NULL;
+  *link = self;
+
+  pte_osMutexUnlock (rwl->queueLock);
+
+  if (abstime == NULL)
+    {
+      pte_park (self);
+      return 0;
+    }
+
+  milliseconds = pte_relmillisecs (abstime);
+
+  if (pte_parkTimed (self, &milliseconds) == 0)
+    {
+      return 0;
+    }
+
+  pte_osMutexLock (rwl->queueLock);
+
+  if (self->parkWoken)
+    {
+      /* Handed the lock as we timed out. */
+      result = 0;
+    }
+  else
+    {
+      for (link = &rwl->waiters; *link != self; link = &(*link)->parkNext)
+        ;
+
+      *link = self->parkNext;
+
+      /* Readers queued only behind us may be able to go now. */
+      pte_rwlock_dispatch (rwl);
+
+      result = ETIMEDOUT;
+    }
+
+  pte_osMutexUnlock (rwl->queueLock);
+
+  return result;
+}
@@ -0,0 +1,75 @@
+/*
+ * pte_sem_check_need_init.c
+ *
+ * Description:
+ * This translation unit implements semaphores.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "semaphore.h"
+#include "implement.h"
+
+
+int
+pte_sem_check_need_init (sem_t * sem)
+{
+  sem_t initializer = *sem;
+  sem_t s;
+
+  /*
+   * Semaphores declared with SEM_INITIALIZER_NP() are created by
+   * whichever thread first uses them. Rather than serialising on a
+   * global lock, each racing thread builds its own semaphore and
+   * tries to install it; the losers throw theirs away.
+   */
+
+  PTE_STAT_ADD (PTE_STAT_SEM_LAZY_INITS, 1);
+
+  if (!PTE_IS_COUNT_INITIALIZER (initializer))
+    {
+      return (initializer == NULL ? EINVAL : 0);
+    }
+
+  if (sem_init (&s, 0, PTE_COUNT_INITIALIZER_VALUE (initializer)) != 0)
+    {
+      return errno;
+    }
+
+  if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR (sem, s, initializer) != initializer)
+    {
+      (void) sem_destroy (&s);
+
+      /*
+       * Another thread installed its semaphore first, or the
+       * semaphore was destroyed before it was ever used.
+       */
+      if (*sem == NULL)
+        {
+          return EINVAL;
+        }
+    }
+
+  return 0;
+}
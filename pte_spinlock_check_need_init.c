@@ -59,6 +59,8 @@ pte_spinlock_check_need_init (pthread_spinlock_t * lock)
    */
 
 
+  PTE_STAT_ADD (PTE_STAT_SPIN_LAZY_INITS, 1);
+
   pte_osMutexLock (pte_spinlock_test_init_lock);
 
   /*
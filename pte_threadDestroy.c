@@ -67,6 +67,7 @@ pte_threadDestroyCommon (pthread_t thread, unsigned char shouldThreadExit)
        * Thread ID structs are never freed. They're NULLed and reused.
        * This also sets the thread to PThreadStateInitial (invalid).
        */
+      PTE_TRACE_THREAD_DONE (tp);
       pte_threadReusePush (thread);
 
       (void) pthread_mutex_destroy(&threadCopy.cancelLock);
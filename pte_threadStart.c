@@ -101,6 +101,9 @@ int pte_threadStart (void *vthreadParms)
 
   sp->state = PThreadStateRunning;
 
+  PTE_TRACE_EVENT (PTE_TRACE_THREAD_START, self);
+  PTE_HOOK_THREAD_START (self);
+
 #ifdef PTE_CLEANUP_C
 
 
@@ -234,6 +237,9 @@ int pte_threadStart (void *vthreadParms)
    * must be cleaned up explicitly by the application
    * (by calling pte_thread_detach_np()).
    */
+  PTE_TRACE_EVENT (PTE_TRACE_THREAD_EXIT, self);
+  PTE_HOOK_THREAD_EXIT (self);
+
   (void) pte_thread_detach_and_exit_np ();
 
   //pte_osThreadExit(status);
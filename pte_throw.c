@@ -69,6 +69,9 @@ pte_throw (unsigned int exception)
       exit (1);
     }
 
+  /* A thread cancelled while blocked is no longer waiting. */
+  pte_waitEnd (sp);
+
   if (NULL == sp || sp->implicit)
     {
       /*
@@ -0,0 +1,161 @@
+/*
+ * pte_trace.c
+ *
+ * Description:
+ * Per-thread lock-free synchronisation event rings (PTE_TRACE builds only).
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include "pthread.h"
+#include "implement.h"
+
+#ifdef PTE_TRACE
+
+/*
+ * Each thread appends to a ring of its own, so writers normally never
+ * contend. Rings are claimed lazily on a thread's first event and
+ * handed back, with their contents intact, when the pthread_t is
+ * recycled; the next thread to claim one simply continues writing
+ * into it. Threads that cannot get a ring of their own (no POSIX
+ * handle, or PTE_TRACE_MAX_RINGS reached) share pte_traceSharedRing,
+ * which is safe for several writers because slots are reserved with
+ * an atomic increment.
+ */
+static pte_trace_ring_t *
+pte_traceClaimRing (void)
+{
+  pte_trace_ring_t * ring;
+  int i, slot;
+
+  for (i = 0; i < pte_traceRingCount && i < PTE_TRACE_MAX_RINGS; i++)
+    {
+      ring = pte_traceRings[i];
+
+      if (ring != NULL &&
+          PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &ring->inUse, 1, 0) == 0)
+        {
+          return ring;
+        }
+    }
+
+  if (pte_traceRingCount >= PTE_TRACE_MAX_RINGS ||
+      (ring = (pte_trace_ring_t *) calloc (1, sizeof (*ring))) == NULL)
+    {
+      return &pte_traceSharedRing;
+    }
+
+  ring->inUse = 1;
+
+  slot = PTE_ATOMIC_INCREMENT (&pte_traceRingCount) - 1;
+
+  if (slot >= PTE_TRACE_MAX_RINGS)
+    {
+      free (ring);
+      return &pte_traceSharedRing;
+    }
+
+  pte_traceRings[slot] = ring;
+
+  return ring;
+}
+
+
+void
+pte_traceEvent (int type, void * object)
+/*
+ * ------------------------------------------------------
+ * DESCRIPTION
+ *      Appends an event to the calling thread's ring. Does
+ *      nothing unless tracing has been switched on with
+ *      pthread_trace_enable_np().
+ * ------------------------------------------------------
+ */
+{
+  pte_thread_t * sp;
+  pte_trace_ring_t * ring = &pte_traceSharedRing;
+  pte_trace_event_t * ev;
+  int idx;
+
+  if (!pte_traceEnabled)
+    {
+      return;
+    }
+
+  sp = (pte_thread_t *) pthread_getspecific (pte_selfThreadKey);
+
+  if (sp != NULL)
+    {
+      if (sp->traceRing == NULL)
+        {
+          sp->traceRing = pte_traceClaimRing ();
+        }
+
+      ring = (pte_trace_ring_t *) sp->traceRing;
+    }
+
+  idx = PTE_ATOMIC_INCREMENT ((int *) &ring->head) - 1;
+  ev = &ring->events[(unsigned int) idx & (PTE_TRACE_RING_SIZE - 1)];
+
+  /*
+   * Invalidate the slot before touching it, so that an exporter
+   * copying the previous entry sees the sequence change and drops its
+   * copy instead of keeping a mix of old and new fields. The exchange
+   * is a full barrier.
+   */
+  (void) PTE_ATOMIC_EXCHANGE ((int *) &ev->seq, 0);
+
+  ev->timestamp = pte_osClockGetNanoseconds ();
+  ev->object = object;
+  ev->thread = (unsigned int) pte_osThreadGetHandle ();
+  ev->type = type;
+
+  /* Publishes the entry. */
+  (void) PTE_ATOMIC_EXCHANGE ((int *) &ev->seq, idx + 1);
+}
+
+
+void
+pte_traceThreadDone (pte_thread_t * tp)
+/*
+ * ------------------------------------------------------
+ * DESCRIPTION
+ *      Releases the ring claimed by 'tp' so that a later
+ *      thread can reuse it. Called before the thread struct
+ *      is wiped for reuse.
+ * ------------------------------------------------------
+ */
+{
+  pte_trace_ring_t * ring = (pte_trace_ring_t *) tp->traceRing;
+
+  if (ring != NULL && ring != &pte_traceSharedRing)
+    {
+      (void) PTE_ATOMIC_EXCHANGE ((int *) &ring->inUse, 0);
+    }
+
+  tp->traceRing = NULL;
+}
+
+#endif /* PTE_TRACE */
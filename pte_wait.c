@@ -0,0 +1,98 @@
+/*
+ * pte_wait.c
+ *
+ * Description:
+ * Records what each thread is blocked on, for pthread_dump_waits_np(),
+ * and calls the before_block/after_wake instrumentation hooks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+/*
+ * The blocking paths call pte_waitBegin() just before they sleep and
+ * pte_waitEnd() once they wake. Only the first call in a nest is
+ * recorded: an rwlock or barrier wait is reported as such rather than
+ * as the internal mutex, condition variable or semaphore it sleeps on.
+ * The record is written only by its own thread and read without
+ * locking by pthread_dump_waits_np(), so the cost is a TLS lookup, a
+ * clock read and a few stores - and only when a thread actually has
+ * to block. The same nesting rule applies to the PTE_HOOKS hooks.
+ */
+pte_thread_t *
+pte_waitBegin (int kind, void * object)
+{
+  /*
+   * Don't use pthread_self() to avoid creating an implicit POSIX thread handle
+   * unnecessarily.
+   */
+  pte_thread_t * tp = (pte_thread_t *) pthread_getspecific (pte_selfThreadKey);
+
+  if (tp == NULL || tp->waitKind != PTE_WAIT_NONE)
+    {
+      return NULL;
+    }
+
+  tp->waitStart = pte_osClockGetNanoseconds ();
+  tp->waitObject = object;
+
+  /* Publish the kind last so a reader never pairs it with a stale object. */
+  (void) PTE_ATOMIC_EXCHANGE ((int *) &tp->waitKind, kind);
+
+#ifdef PTE_HOOKS
+  {
+    void (*hook) (int, void *) = pte_hooks.before_block;
+
+    if (hook != NULL)
+      {
+        hook (kind, object);
+      }
+  }
+#endif
+
+  return tp;
+}
+
+/*
+ * Ends the wait started by the pte_waitBegin() call that returned
+ * 'waiter'. NULL (a nested or unrecorded wait) is ignored.
+ */
+void
+pte_waitEnd (pte_thread_t * waiter)
+{
+  if (waiter != NULL)
+    {
+#ifdef PTE_HOOKS
+      void (*hook) (int, void *) = pte_hooks.after_wake;
+
+      if (hook != NULL)
+        {
+          hook (waiter->waitKind, waiter->waitObject);
+        }
+#endif
+
+      waiter->waitKind = PTE_WAIT_NONE;
+    }
+}
@@ -109,6 +109,7 @@ pthread_attr_init (pthread_attr_t * attr)
    */
   attr_result->param.sched_priority = pte_osThreadGetDefaultPriority();
   attr_result->inheritsched = PTHREAD_EXPLICIT_SCHED;
+  attr_result->policy = SCHED_OTHER;
   attr_result->contentionscope = PTHREAD_SCOPE_SYSTEM;
 
   attr_result->valid = PTE_ATTR_VALID;
@@ -49,7 +49,6 @@
 int
 pthread_barrier_destroy (pthread_barrier_t * barrier)
 {
-  int result = 0;
   pthread_barrier_t b;
 
   if (barrier == NULL || *barrier == (pthread_barrier_t) PTE_OBJECT_INVALID)
@@ -58,18 +57,34 @@ pthread_barrier_destroy (pthread_barrier_t * barrier)
     }
 
   b = *barrier;
-  *barrier = NULL;
 
-  if (0 == (result = sem_destroy (&(b->semBarrierBreeched[0]))))
+  if (PTE_IS_COUNT_INITIALIZER (b))
     {
-      if (0 == (result = sem_destroy (&(b->semBarrierBreeched[1]))))
+      /* Static barrier that was never used, nothing to free. */
+      if (PTE_ATOMIC_COMPARE_EXCHANGE_PTR (barrier, NULL, b) == b)
         {
-          (void) free (b);
           return 0;
         }
-      (void) sem_init (&(b->semBarrierBreeched[0]), b->pshared, 0);
+
+      if ((b = *barrier) == NULL)
+        {
+          return EINVAL;
+        }
     }
 
-  *barrier = b;
-  return (result);
+  if (b->remaining != (int) b->count)
+    {
+      /* Some threads are parked waiting for the rest to arrive. */
+      return EBUSY;
+    }
+
+  /*
+   * Released threads never touch the barrier again, so it can be
+   * freed even if they have not yet returned from
+   * pthread_barrier_wait().
+   */
+  *barrier = NULL;
+  (void) free (b);
+
+  return 0;
 }
@@ -40,6 +40,7 @@
  *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
  */
 
+#include <limits.h>
 #include <stdlib.h>
 
 #include "pthread.h"
@@ -52,38 +53,26 @@ pthread_barrier_init (pthread_barrier_t * barrier,
 {
   pthread_barrier_t b;
 
-  if (barrier == NULL || count == 0)
+  if (barrier == NULL || count == 0 || count > (unsigned int) INT_MAX)
     {
       return EINVAL;
     }
 
-  if (NULL != (b = (pthread_barrier_t) calloc (1, sizeof (*b))))
+  /*
+   * A barrier is a counter and a list of parked threads, so it needs
+   * no OS objects of its own (see pthread_barrier_wait.c).
+   */
+  if (NULL == (b = (pthread_barrier_t) calloc (1, sizeof (*b))))
     {
-      b->pshared = (attr != NULL && *attr != NULL
-                    ? (*attr)->pshared : PTHREAD_PROCESS_PRIVATE);
-
-      b->nCurrentBarrierHeight = b->nInitialBarrierHeight = count;
-      b->iStep = 0;
-
-      /*
-       * Two semaphores are used in the same way as two stepping
-       * stones might be used in crossing a stream. Once all
-       * threads are safely on one stone, the other stone can
-       * be moved ahead, and the threads can start moving to it.
-       * If some threads decide to eat their lunch before moving
-       * then the other threads have to wait.
-       */
-      if (0 == sem_init (&(b->semBarrierBreeched[0]), b->pshared, 0))
-        {
-          if (0 == sem_init (&(b->semBarrierBreeched[1]), b->pshared, 0))
-            {
-              *barrier = b;
-              return 0;
-            }
-          (void) sem_destroy (&(b->semBarrierBreeched[0]));
-        }
-      (void) free (b);
+      return ENOMEM;
     }
 
-  return ENOMEM;
+  b->pshared = (attr != NULL && *attr != NULL
+                ? (*attr)->pshared : PTHREAD_PROCESS_PRIVATE);
+  b->count = count;
+  b->remaining = (int) count;
+  b->waiters = NULL;
+
+  *barrier = b;
+  return 0;
 }
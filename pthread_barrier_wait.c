@@ -48,54 +48,88 @@ int
 pthread_barrier_wait (pthread_barrier_t * barrier)
 {
   int result;
-  int step;
   pthread_barrier_t b;
+  pte_thread_t * self;
+  pte_thread_t * head;
+  pte_thread_t * waiter;
 
   if (barrier == NULL || *barrier == (pthread_barrier_t) PTE_OBJECT_INVALID)
     {
       return EINVAL;
     }
 
+  if (PTE_IS_COUNT_INITIALIZER (*barrier)
+      && (result = pte_barrier_check_need_init (barrier)) != 0)
+    {
+      return result;
+    }
+
   b = *barrier;
-  step = b->iStep;
 
-  if (0 == PTE_ATOMIC_DECREMENT ((int *) &(b->nCurrentBarrierHeight)))
+  if ((self = (pte_thread_t *) pthread_self ()) == NULL)
     {
-      /* Must be done before posting the semaphore. */
-      b->nCurrentBarrierHeight = b->nInitialBarrierHeight;
+      return ENOMEM;
+    }
 
-      /*
-       * There is no race condition between the semaphore wait and post
-       * because we are using two alternating semas and all threads have
-       * entered barrier_wait and checked nCurrentBarrierHeight before this
-       * barrier's sema can be posted. Any threads that have not quite
-       * entered sem_wait below when the multiple_post has completed
-       * will nevertheless continue through the semaphore (barrier)
-       * and will not be left stranded.
-       */
-      result = (b->nInitialBarrierHeight > 1
-                ? sem_post_multiple (&(b->semBarrierBreeched[step]),
-                                     b->nInitialBarrierHeight - 1) : 0);
+  if (b->count > 1 && (result = pte_parkPrepare (self)) != 0)
+    {
+      return result;
+    }
+
+  /*
+   * Join the waiter list before arriving, so that the thread that
+   * arrives last finds every other thread of this cycle on it.
+   */
+  do
+    {
+      head = b->waiters;
+      self->parkNext = head;
     }
-  else
+  while (PTE_ATOMIC_COMPARE_EXCHANGE_PTR (&b->waiters, self, head) != head);
+
+  if (0 == PTE_ATOMIC_DECREMENT ((int *) &b->remaining))
     {
       /*
-       * Use the non-cancelable version of sem_wait().
+       * Last to arrive. Everybody else is parked, so nobody can
+       * touch the barrier until they have been woken: take the list,
+       * rearm the barrier, then wake them.
        */
-      result = sem_wait (&(b->semBarrierBreeched[step]));
-//      result = sem_wait_nocancel (&(b->semBarrierBreeched[step]));
+      do
+        {
+          head = b->waiters;
+        }
+      while (PTE_ATOMIC_COMPARE_EXCHANGE_PTR (&b->waiters, NULL, head) != head);
+
+      b->remaining = (int) b->count;
+
+      while (head != NULL)
+        {
+          /*
+           * Read the link first: once woken, a thread may arrive at
+           * the next cycle and relink itself.
+           */
+          waiter = head->parkNext;
+
+          if (head != self)
+            {
+              pte_unpark (head);
+            }
+
+          head = waiter;
+        }
+
+      /*
+       * The thread that trips the barrier is the serial thread.
+       */
+      return PTHREAD_BARRIER_SERIAL_THREAD;
     }
 
   /*
-   * The first thread across will be the PTHREAD_BARRIER_SERIAL_THREAD.
-   * This also sets up the alternate semaphore as the next barrier.
+   * Not a cancellation point, so parking ignores cancellation.
    */
-  if (0 == result)
-    {
-      result = (step ==
-                PTE_ATOMIC_COMPARE_EXCHANGE (& (b->iStep),(1L - step),step) ?
-                PTHREAD_BARRIER_SERIAL_THREAD : 0);
-    }
+  waiter = pte_waitBegin (PTE_WAIT_BARRIER, b);
+  pte_park (self);
+  pte_waitEnd (waiter);
 
-  return (result);
+  return 0;
 }
@@ -103,6 +103,8 @@ pthread_cancel (pthread_t thread)
 
   tp = (pte_thread_t *) thread;
 
+  PTE_TRACE_EVENT (PTE_TRACE_CANCEL, thread);
+
   /*
    * Lock for async-cancel safety.
    */
@@ -72,6 +72,8 @@ pthread_cond_init (pthread_cond_t * cond, const pthread_condattr_t * attr)
  *                              memory,
  *              ENOMEM          insufficient memory,
  *              EBUSY           'cond' is already initialized,
+ *              ENOTSUP         priority wake order requested, and the
+ *                              OS cannot provide it.
  *
  * ------------------------------------------------------
  */
@@ -113,7 +115,13 @@ pthread_cond_init (pthread_cond_t * cond, const pthread_condattr_t * attr)
       goto FAIL0;
     }
 
-  if (sem_init (&(cv->semBlockQueue), 0, 0) != 0)
+  /*
+   * Waiters block on semBlockQueue, so it decides the wake order.
+   */
+  if (sem_init_np (&(cv->semBlockQueue), 0, 0,
+                   (attr != NULL && *attr != NULL
+                    && (*attr)->wakeOrder == PTHREAD_WAKE_PRIORITY_NP)
+                   ? SEM_WAKE_PRIORITY_NP : SEM_WAKE_DEFAULT_NP) != 0)
     {
       result = errno;
       goto FAIL1;
@@ -359,11 +359,13 @@ pte_cond_wait_cleanup (void *args)
 
 static int
 pte_cond_timedwait (pthread_cond_t * cond,
-                    pthread_mutex_t * mutex, const struct timespec *abstime)
+                    pthread_mutex_t * mutex, const struct timespec *abstime,
+                    const struct timespec *reltime)
 {
   int result = 0;
   pthread_cond_t cv;
   pte_cond_wait_cleanup_args_t cleanup_args;
+  pte_thread_t * waiter;
 
   if (cond == NULL || *cond == NULL)
     {
@@ -431,10 +433,18 @@ pte_cond_timedwait (pthread_cond_t * cond,
        *      re-lock the mutex and adjust (to)unblock(ed) waiters
        *      counts if we are cancelled, timed out or signalled.
        */
-      if (sem_timedwait (&(cv->semBlockQueue), abstime) != 0)
+      PTE_TRACE_EVENT (PTE_TRACE_COND_WAIT, cv);
+      waiter = pte_waitBegin (PTE_WAIT_COND, cv);
+
+      if ((reltime != NULL
+           ? sem_reltimedwait_np (&(cv->semBlockQueue), reltime)
+           : sem_timedwait (&(cv->semBlockQueue), abstime)) != 0)
         {
           result = errno;
         }
+
+      pte_waitEnd (waiter);
+      PTE_TRACE_EVENT (PTE_TRACE_COND_WAKE, cv);
     }
 
 
@@ -504,7 +514,7 @@ pthread_cond_wait (pthread_cond_t * cond, pthread_mutex_t * mutex)
   /*
    * The NULL abstime arg means INFINITE waiting.
    */
-  return (pte_cond_timedwait (cond, mutex, NULL));
+  return (pte_cond_timedwait (cond, mutex, NULL, NULL));
 
 }				/* pthread_cond_wait */
 
@@ -563,6 +573,58 @@ pthread_cond_timedwait (pthread_cond_t * cond,
       return EINVAL;
     }
 
-  return (pte_cond_timedwait (cond, mutex, abstime));
+  return (pte_cond_timedwait (cond, mutex, abstime, NULL));
 
 }				/* pthread_cond_timedwait */
+
+
+int
+pthread_cond_timedwait_relative_np (pthread_cond_t * cond,
+                                    pthread_mutex_t * mutex,
+                                    const struct timespec *reltime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits on a condition variable either until
+ *      awakened by a signal or broadcast; or until the interval
+ *      reltime passes.
+ *
+ * PARAMETERS
+ *      cond
+ *              pointer to an instance of pthread_cond_t
+ *
+ *      mutex
+ *              pointer to an instance of pthread_mutex_t
+ *
+ *      reltime
+ *              pointer to an instance of (const struct timespec)
+ *
+ *
+ * DESCRIPTION
+ *      As pthread_cond_timedwait(), but the timeout is counted
+ *      from the call and is passed to the OS without reading the
+ *      clock. The condition variable's clock attribute does not
+ *      apply.
+ *
+ *
+ * RESULTS
+ *              0               caught condition; mutex released,
+ *              EINVAL          'cond', 'mutex', or reltime is invalid,
+ *              EINVAL          different mutexes for concurrent waits,
+ *              EINVAL          mutex is not held by the calling thread,
+ *              ETIMEDOUT       reltime ellapsed before cond was signaled.
+ *
+ * ------------------------------------------------------
+ */
+{
+  unsigned int milliseconds;
+
+  /* Reject a bad interval before releasing the mutex. */
+  if (pte_reltimeout (reltime, &milliseconds) != 0)
+    {
+      return EINVAL;
+    }
+
+  return (pte_cond_timedwait (cond, mutex, NULL, reltime));
+
+}				/* pthread_cond_timedwait_relative_np */
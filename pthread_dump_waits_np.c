@@ -0,0 +1,320 @@
+/*
+ * pthread_dump_waits_np.c
+ *
+ * Description:
+ * Reports what every thread is blocked on and finds mutex deadlocks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pthread.h"
+#include "implement.h"
+
+
+typedef struct
+  {
+    pte_thread_t * thread;
+    unsigned int osThread;
+    int kind;
+    void * object;
+    unsigned long long start;
+    pte_thread_t * owner;	/* NULL if none or not known */
+  } pte_wait_snapshot_t;
+
+static const char * const pte_waitNames[PTE_WAIT_KINDS] =
+{
+  "running",
+  "mutex",
+  "cond",
+  "sem",
+  "rwlock",
+  "barrier",
+  "join"
+};
+
+/*
+ * Index of 'thread' in the snapshot, or -1.
+ */
+static int
+pte_waitFind (pte_wait_snapshot_t * waits, int count, pte_thread_t * thread)
+{
+  int i;
+
+  for (i = 0; i < count; i++)
+    {
+      if (waits[i].thread == thread)
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/*
+ * Follows owner links from 'start'. Returns 1 (and writes the cycle)
+ * if they lead back to 'start' and 'start' is the lowest index on the
+ * cycle, so that each cycle is reported once.
+ */
+static int
+pte_waitReportCycle (pte_wait_snapshot_t * waits, int count, int start,
+                     void (*write) (const char * text, void * arg),
+                     void * arg)
+{
+  char line[96];
+  int i, step;
+
+  i = start;
+
+  for (step = 0; step < count; step++)
+    {
+      i = pte_waitFind (waits, count, waits[i].owner);
+
+      if (i < 0 || i < start)
+        {
+          return 0;
+        }
+
+      if (i == start)
+        {
+          break;
+        }
+    }
+
+  if (i != start)
+    {
+      return 0;
+    }
+
+  write ("deadlock:", arg);
+
+  do
+    {
+      snprintf (line, sizeof (line), " thread %p -> %s %p ->",
+                (void *) waits[i].thread,
+                pte_waitNames[waits[i].kind],
+                waits[i].object);
+      write (line, arg);
+      i = pte_waitFind (waits, count, waits[i].owner);
+    }
+  while (i != start);
+
+  snprintf (line, sizeof (line), " thread %p\n", (void *) waits[start].thread);
+  write (line, arg);
+
+  return 1;
+}
+
+
+int
+pthread_dump_waits_np (void (*write) (const char * text, void * arg),
+                       void * arg)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Writes one line per thread saying what, if anything,
+ *      it is blocked on, then one line per deadlock found.
+ *
+ * PARAMETERS
+ *      write
+ *              called with successive NUL-terminated pieces
+ *              of the report, in order.
+ *
+ *      arg
+ *              passed through to 'write'.
+ *
+ * DESCRIPTION
+ *      Waits on mutexes, condition variables, semaphores,
+ *      read-write locks, barriers and pthread_join() are
+ *      reported with the object, how long the thread has
+ *      been waiting, and the owner where it is known. A
+ *      mutex's owner is known for recursive and error
+ *      checking mutexes and, in builds with PTE_HOOKS or
+ *      PTE_TRACE, for normal mutexes that were acquired
+ *      after contention; a joined thread is the owner of a
+ *      join.
+ *
+ *      Following owners from waiting thread to waiting
+ *      thread finds deadlocks, e.g. two threads each
+ *      waiting for a mutex the other holds; each cycle is
+ *      reported as a "deadlock:" line.
+ *
+ *      Other threads keep running while the report is
+ *      built, so it is a best-effort snapshot. Threads that
+ *      are not POSIX threads and never called
+ *      pthread_self() are not listed.
+ *
+ * RESULTS
+ *              0               report written, no deadlock,
+ *              EDEADLK         report written, deadlock found,
+ *              EINVAL          'write' is NULL,
+ *              ENOMEM          no memory for the snapshot.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_wait_snapshot_t * waits = NULL;
+  pte_thread_t * tp;
+  int capacity = 0;
+  unsigned long long now;
+  char line[128];
+  int count = 0;
+  int deadlocks = 0;
+  int i;
+
+  if (write == NULL)
+    {
+      return EINVAL;
+    }
+
+  /*
+   * pte_threadReusePush() briefly wipes the list link while
+   * recycling a thread, so walk the list under the same lock.
+   * Allocating under that lock would stall pthread_create() and
+   * thread exit, so size the snapshot first and allocate with the
+   * lock released, trying again if the list grew meanwhile.
+   */
+  for (;;)
+    {
+      pte_osMutexLock (pte_thread_reuse_lock);
+
+      count = 0;
+
+      for (tp = pte_threadList; tp != NULL; tp = tp->nextThread)
+        {
+          count++;
+        }
+
+      if (waits != NULL && count <= capacity)
+        {
+          break;
+        }
+
+      pte_osMutexUnlock (pte_thread_reuse_lock);
+
+      free (waits);
+      capacity = count > 0 ? count : 1;
+      waits = (pte_wait_snapshot_t *) calloc (capacity, sizeof (*waits));
+
+      if (waits == NULL)
+        {
+          return ENOMEM;
+        }
+    }
+
+  count = 0;
+
+  for (tp = pte_threadList; tp != NULL; tp = tp->nextThread)
+    {
+      pte_wait_snapshot_t * w = &waits[count];
+      int kind = tp->waitKind;
+
+      /* Recycled structs have no OS thread. */
+      if (tp->threadId == 0)
+        {
+          continue;
+        }
+
+      w->thread = tp;
+      w->osThread = (unsigned int) tp->threadId;
+      w->object = tp->waitObject;
+      w->start = tp->waitStart;
+      w->kind = (kind > PTE_WAIT_NONE && kind < PTE_WAIT_KINDS) ? kind : PTE_WAIT_NONE;
+
+      if (w->kind == PTE_WAIT_MUTEX && w->object != NULL)
+        {
+          /*
+           * Read the owner as it is now, since the mutex may have
+           * changed hands since the wait began. A thread blocked on
+           * a mutex keeps it from being destroyed, so the read is
+           * safe if the thread is still blocked on it afterwards;
+           * otherwise drop the edge.
+           */
+          w->owner = (pte_thread_t *) ((pthread_mutex_t) w->object)->ownerThread;
+
+          if (PTE_ATOMIC_EXCHANGE_ADD ((int *) &tp->waitKind, 0) != kind
+              || tp->waitObject != w->object)
+            {
+              w->owner = NULL;
+            }
+        }
+      else if (w->kind == PTE_WAIT_JOIN)
+        {
+          w->owner = (pte_thread_t *) w->object;
+        }
+
+      count++;
+    }
+
+  pte_osMutexUnlock (pte_thread_reuse_lock);
+
+  now = pte_osClockGetNanoseconds ();
+
+  for (i = 0; i < count; i++)
+    {
+      pte_wait_snapshot_t * w = &waits[i];
+
+      if (w->kind == PTE_WAIT_NONE)
+        {
+          snprintf (line, sizeof (line), "thread %p (os %u): running\n",
+                    (void *) w->thread, w->osThread);
+        }
+      else
+        {
+          unsigned long long usecs = now > w->start ? (now - w->start) / 1000 : 0;
+
+          if (w->owner != NULL)
+            {
+              snprintf (line, sizeof (line),
+                        "thread %p (os %u): %s %p for %llu us, owner thread %p\n",
+                        (void *) w->thread, w->osThread,
+                        pte_waitNames[w->kind], w->object, usecs,
+                        (void *) w->owner);
+            }
+          else
+            {
+              snprintf (line, sizeof (line),
+                        "thread %p (os %u): %s %p for %llu us\n",
+                        (void *) w->thread, w->osThread,
+                        pte_waitNames[w->kind], w->object, usecs);
+            }
+        }
+
+      write (line, arg);
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      if (waits[i].owner != NULL)
+        {
+          deadlocks += pte_waitReportCycle (waits, count, i, write, arg);
+        }
+    }
+
+  free (waits);
+
+  return deadlocks > 0 ? EDEADLK : 0;
+}
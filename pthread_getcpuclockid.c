@@ -0,0 +1,102 @@
+/*
+ * pthread_getcpuclockid.c
+ *
+ * Description:
+ * POSIX thread functions related to thread CPU-time clocks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+int
+pthread_getcpuclockid (pthread_t thread, clockid_t * clock_id)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function returns the clock ID of the CPU-time
+ *      clock of 'thread'.
+ *
+ * PARAMETERS
+ *      thread
+ *              reference to an instance of pthread_t
+ *
+ *      clock_id
+ *              set to the clock ID
+ *
+ * DESCRIPTION
+ *      The C library's clock_gettime() only knows the CPU-time
+ *      clock of the calling thread, CLOCK_THREAD_CPUTIME_ID,
+ *      so that is the only thread a clock ID can be returned
+ *      for. pthread_getcputime_np() reads the CPU time of any
+ *      thread.
+ *
+ * RESULTS
+ *              0               successfully returned the clock ID,
+ *              EINVAL          'clock_id' is NULL,
+ *              ENOENT          'thread' is not the calling thread, or
+ *                              the OS does not account CPU time per
+ *                              thread,
+ *              ENOTSUP         the C library has no
+ *                              CLOCK_THREAD_CPUTIME_ID,
+ *              ESRCH           no thread found corresponding to 'thread'.
+ * ------------------------------------------------------
+ */
+{
+  int result;
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  unsigned long long microseconds;
+#endif
+
+  result = pthread_kill (thread, 0);
+
+  if (0 != result)
+    {
+      return result;
+    }
+
+  if (clock_id == NULL)
+    {
+      return EINVAL;
+    }
+
+#ifndef CLOCK_THREAD_CPUTIME_ID
+
+  return ENOTSUP;
+
+#else
+
+  if (!pthread_equal (thread, pthread_self ())
+      || pte_osThreadGetCpuTime (((pte_thread_t *) thread)->threadId,
+                                 &microseconds) != PTE_OS_OK)
+    {
+      return ENOENT;
+    }
+
+  *clock_id = CLOCK_THREAD_CPUTIME_ID;
+
+  return 0;
+
+#endif
+}
@@ -0,0 +1,90 @@
+/*
+ * pthread_getcputime_np.c
+ *
+ * Description:
+ * POSIX thread functions related to thread CPU-time clocks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+int
+pthread_getcputime_np (pthread_t thread, struct timespec * cputime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function returns the CPU time consumed so far
+ *      by 'thread'.
+ *
+ * PARAMETERS
+ *      thread
+ *              reference to an instance of pthread_t
+ *
+ *      cputime
+ *              set to the CPU time used by 'thread'
+ *
+ * DESCRIPTION
+ *      This function returns the CPU time consumed so far
+ *      by 'thread', which need not be the calling thread.
+ *      It is one OS query, cheap enough for a profiler to
+ *      sample worker threads periodically.
+ *
+ * RESULTS
+ *              0               successfully returned the CPU time,
+ *              EINVAL          'cputime' is NULL,
+ *              ENOTSUP         the OS does not account CPU time per
+ *                              thread,
+ *              ESRCH           no thread found corresponding to 'thread'.
+ * ------------------------------------------------------
+ */
+{
+  const unsigned long long MICROSEC_PER_SEC = 1000000;
+  const long NANOSEC_PER_MICROSEC = 1000;
+  int result;
+  unsigned long long microseconds;
+
+  result = pthread_kill (thread, 0);
+
+  if (0 != result)
+    {
+      return result;
+    }
+
+  if (cputime == NULL)
+    {
+      return EINVAL;
+    }
+
+  if (pte_osThreadGetCpuTime (((pte_thread_t *) thread)->threadId,
+                              &microseconds) != PTE_OS_OK)
+    {
+      return ENOTSUP;
+    }
+
+  cputime->tv_sec = (time_t) (microseconds / MICROSEC_PER_SEC);
+  cputime->tv_nsec = (long) (microseconds % MICROSEC_PER_SEC) * NANOSEC_PER_MICROSEC;
+
+  return 0;
+}
@@ -67,7 +67,7 @@ pthread_getschedparam (pthread_t thread, int *policy,
     }
 
   /* Fill out the policy. */
-  *policy = SCHED_OTHER;
+  *policy = ((pte_thread_t *)thread)->sched_policy;
 
   /*
    * This function must return the priority value set by
@@ -0,0 +1,100 @@
+/*
+ * pthread_getstats_np.c
+ *
+ * Description:
+ * Takes a snapshot of the library statistics counters.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_getstats_np (pthread_stats_np_t * stats)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Copies the library statistics counters into 'stats'.
+ *
+ * PARAMETERS
+ *      stats
+ *              pointer to a pthread_stats_np_t to fill in.
+ *
+ * DESCRIPTION
+ *      Statistics are only collected when the library is
+ *      built with PTE_STATS defined. Counters are updated
+ *      without locking, so the snapshot is not taken at a
+ *      single instant: each field is accurate on its own,
+ *      but related fields may be slightly out of step while
+ *      other threads are running.
+ *
+ *      OS object counts come from the OSAL and only include
+ *      objects created through it; the reuse queue depth,
+ *      thread reuse and lazy-init counts come from the core.
+ *
+ * RESULTS
+ *              0               successfully copied,
+ *              EINVAL          'stats' is NULL,
+ *              ENOSYS          statistics not built in.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_STATS
+  int snapshot[PTE_STAT_COUNT];
+  int i;
+
+  if (stats == NULL)
+    {
+      return EINVAL;
+    }
+
+  for (i = 0; i < PTE_STAT_COUNT; i++)
+    {
+      snapshot[i] = PTE_ATOMIC_EXCHANGE_ADD (&pte_stats[i], 0);
+    }
+
+  stats->osSemaphores = snapshot[PTE_STAT_OS_SEMAPHORES];
+  stats->osMutexes = snapshot[PTE_STAT_OS_MUTEXES];
+  stats->osThreads = snapshot[PTE_STAT_OS_THREADS];
+  stats->osTlsKeys = snapshot[PTE_STAT_OS_TLS_KEYS];
+  stats->reuseDepth = snapshot[PTE_STAT_REUSE_DEPTH];
+
+  stats->osSemaphoresCreated = snapshot[PTE_STAT_OS_SEMAPHORES_CREATED];
+  stats->osMutexesCreated = snapshot[PTE_STAT_OS_MUTEXES_CREATED];
+  stats->osThreadsCreated = snapshot[PTE_STAT_OS_THREADS_CREATED];
+  stats->threadsReused = snapshot[PTE_STAT_THREADS_REUSED];
+  stats->mutexLazyInits = snapshot[PTE_STAT_MUTEX_LAZY_INITS];
+  stats->condLazyInits = snapshot[PTE_STAT_COND_LAZY_INITS];
+  stats->rwlockLazyInits = snapshot[PTE_STAT_RWLOCK_LAZY_INITS];
+  stats->spinLazyInits = snapshot[PTE_STAT_SPIN_LAZY_INITS];
+  stats->semLazyInits = snapshot[PTE_STAT_SEM_LAZY_INITS];
+  stats->barrierLazyInits = snapshot[PTE_STAT_BARRIER_LAZY_INITS];
+
+  return 0;
+#else
+  return ENOSYS;
+#endif
+}
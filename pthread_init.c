@@ -85,7 +85,6 @@ int pthread_init(void)
   pte_osMutexCreate (&pte_rwlock_test_init_lock);
   pte_osMutexCreate (&pte_spinlock_test_init_lock);
 
-
   return (pte_processInitialized);
 
 }
@@ -86,6 +86,7 @@ pthread_join (pthread_t thread, void **value_ptr)
   int result;
   pthread_t self;
   pte_thread_t * tp = (pte_thread_t *) thread;
+  pte_thread_t * waiter;
 
 
   pte_osMutexLock (pte_thread_reuse_lock);
@@ -130,7 +131,9 @@ pthread_join (pthread_t thread, void **value_ptr)
            * are canceled.
            */
 
+          waiter = pte_waitBegin (PTE_WAIT_JOIN, tp);
           result = pte_osThreadWaitForEnd(tp->threadId);
+          pte_waitEnd (waiter);
 
           if (PTE_OS_OK == result)
             {
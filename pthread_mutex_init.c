@@ -73,8 +73,21 @@ pthread_mutex_init (pthread_mutex_t * mutex, const pthread_mutexattr_t * attr)
                   ? PTHREAD_MUTEX_DEFAULT : (*attr)->kind);
       mx->ownerThread = 0;
 
-      pte_osSemaphoreCreate(0,&mx->handle);
-
+      if (attr != NULL && *attr != NULL
+          && (*attr)->wakeOrder == PTHREAD_WAKE_PRIORITY_NP)
+        {
+          if (pte_osSemaphoreCreateEx(0, PTE_OS_SEMAPHORE_PRIORITY,
+                                      &mx->handle) != PTE_OS_OK)
+            {
+              free(mx);
+              mx = NULL;
+              result = ENOTSUP;
+            }
+        }
+      else
+        {
+          pte_osSemaphoreCreate(0,&mx->handle);
+        }
     }
 
   *mutex = mx;
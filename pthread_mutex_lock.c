@@ -47,11 +47,38 @@
 #include "implement.h"
 
 
+/*
+ * Polls a held mutex for up to pte_mutexSpinCount tries before the
+ * caller blocks, in case its owner is running on another CPU and is
+ * about to release it. Returns 0 if the mutex was taken.
+ */
+static int
+pte_mutex_spin (pthread_mutex_t mx)
+{
+  int spins;
+
+  for (spins = pte_mutexSpinCount; spins > 0; spins--)
+    {
+      if (*(volatile int *) &mx->lock_idx == 0
+          && PTE_ATOMIC_COMPARE_EXCHANGE (&mx->lock_idx, 1, 0) == 0)
+        {
+          return 0;
+        }
+
+      PTE_CPU_RELAX ();
+    }
+
+  return EBUSY;
+}
+
+
 int
 pthread_mutex_lock (pthread_mutex_t * mutex)
 {
   int result = 0;
   pthread_mutex_t mx;
+  pte_thread_t * waiter;
+  int prev;
 
   /*
    * Let the system deal with invalid pointers.
@@ -79,10 +106,19 @@ pthread_mutex_lock (pthread_mutex_t * mutex)
 
   if (mx->kind == PTHREAD_MUTEX_NORMAL)
     {
-      if (PTE_ATOMIC_EXCHANGE(
-            &mx->lock_idx,
-            1) != 0)
+      prev = PTE_ATOMIC_EXCHANGE(&mx->lock_idx, 1);
+
+      /*
+       * Only poll if nobody is blocked yet; otherwise the exchange has
+       * just replaced a -1 with 1, which the loop below must put back.
+       */
+      if (prev != 0
+          && (prev < 0 || pte_mutex_spin (mx) != 0))
         {
+          PTE_TRACE_EVENT (PTE_TRACE_MUTEX_CONTENDED, mx);
+
+          waiter = pte_waitBegin (PTE_WAIT_MUTEX, mx);
+
           while (PTE_ATOMIC_EXCHANGE(&mx->lock_idx,-1) != 0)
             {
               if (pte_osSemaphorePend(mx->handle,NULL) != PTE_OS_OK)
@@ -91,13 +127,31 @@ pthread_mutex_lock (pthread_mutex_t * mutex)
                   break;
                 }
             }
+
+          pte_waitEnd (waiter);
+          PTE_PROFILE_SAMPLE (waiter);
+
+          /*
+           * Normal mutexes don't track their owner on the fast path;
+           * record it here, where it costs nothing extra, so that
+           * pthread_dump_waits_np() can follow waits through it.
+           */
+          if (0 == result && waiter != NULL)
+            {
+              PTE_NORMAL_OWNER_SET (mx, waiter);
+            }
+
+          PTE_TRACE_EVENT (PTE_TRACE_MUTEX_ACQUIRED, mx);
+          PTE_HOOK_LOCK_ACQUIRED (mx);
         }
     }
   else
     {
       pthread_t self = pthread_self();
 
-      if (PTE_ATOMIC_COMPARE_EXCHANGE(&mx->lock_idx,1,0) == 0)
+      if (PTE_ATOMIC_COMPARE_EXCHANGE(&mx->lock_idx,1,0) == 0
+          || (!pthread_equal (mx->ownerThread, self)
+              && pte_mutex_spin (mx) == 0))
         {
           mx->recursive_count = 1;
           mx->ownerThread = self;
@@ -117,6 +171,10 @@ pthread_mutex_lock (pthread_mutex_t * mutex)
             }
           else
             {
+              PTE_TRACE_EVENT (PTE_TRACE_MUTEX_CONTENDED, mx);
+
+              waiter = pte_waitBegin (PTE_WAIT_MUTEX, mx);
+
               while (PTE_ATOMIC_EXCHANGE(&mx->lock_idx,-1) != 0)
                 {
                   if (pte_osSemaphorePend(mx->handle,NULL) != PTE_OS_OK)
@@ -126,11 +184,17 @@ pthread_mutex_lock (pthread_mutex_t * mutex)
                     }
                 }
 
+              pte_waitEnd (waiter);
+              PTE_PROFILE_SAMPLE (waiter);
+
               if (0 == result)
                 {
                   mx->recursive_count = 1;
                   mx->ownerThread = self;
                 }
+
+              PTE_TRACE_EVENT (PTE_TRACE_MUTEX_ACQUIRED, mx);
+              PTE_HOOK_LOCK_ACQUIRED (mx);
             }
         }
 
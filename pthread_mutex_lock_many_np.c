@@ -0,0 +1,156 @@
+/*
+ * pthread_mutex_lock_many_np.c
+ *
+ * Description:
+ * This translation unit implements mutual exclusion (mutex) primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_mutex_lock_many_np (pthread_mutex_t * const * mutexes, int count)
+/*
+ * ------------------------------------------------------
+ * DESCRIPTION
+ *      Acquires every mutex in 'mutexes' without risk of
+ *      lock-order deadlock against other callers of this
+ *      function or against code that locks in address order.
+ *
+ *      The set is walked in ascending address order. The thread
+ *      blocks on one mutex only (the "parked" mutex, initially the
+ *      lowest) and try-locks the rest. If one of them is busy all
+ *      locks taken so far are released and the thread parks on the
+ *      contended mutex instead, so it sleeps in the OS rather than
+ *      spinning while the owner finishes.
+ *
+ *      Mutexes that appear more than once in the set are only
+ *      locked once.
+ *
+ * PARAMETERS
+ *      mutexes
+ *              array of pointers to pthread_mutex_t
+ *
+ *      count
+ *              number of entries in 'mutexes'
+ *
+ * RESULTS
+ *              0               all mutexes locked,
+ *              EINVAL          'mutexes' or an entry is invalid,
+ *              EDEADLK         the calling thread already owns an
+ *                              ERRORCHECK mutex in the set.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int result = 0;
+  int i;
+  int park;
+
+  if (mutexes == NULL || count <= 0)
+    {
+      return EINVAL;
+    }
+
+  /*
+   * Materialise any statically initialised mutexes first so that
+   * every entry has its final address before we order the set.
+   */
+  for (i = 0; i < count; i++)
+    {
+      if (mutexes[i] == NULL || *mutexes[i] == NULL)
+        {
+          return EINVAL;
+        }
+
+      if (*mutexes[i] >= PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
+        {
+          if ((result = pte_mutex_check_need_init (mutexes[i])) != 0)
+            {
+              return (result);
+            }
+        }
+    }
+
+  park = pte_mutex_next_in_order (mutexes, count, -1);
+
+  for (;;)
+    {
+      int busy = -1;
+
+      if ((result = pthread_mutex_lock (mutexes[park])) != 0)
+        {
+          return (result);
+        }
+
+      for (i = pte_mutex_next_in_order (mutexes, count, -1);
+           i >= 0;
+           i = pte_mutex_next_in_order (mutexes, count, i))
+        {
+          if (i == park)
+            {
+              continue;
+            }
+
+          if ((result = pthread_mutex_trylock (mutexes[i])) != 0)
+            {
+              busy = i;
+              break;
+            }
+        }
+
+      if (busy < 0)
+        {
+          return 0;
+        }
+
+      /*
+       * Back off: release everything below the busy mutex that we
+       * took on this pass, then the parked mutex itself.
+       */
+      for (i = pte_mutex_next_in_order (mutexes, count, -1);
+           i != busy;
+           i = pte_mutex_next_in_order (mutexes, count, i))
+        {
+          if (i != park)
+            {
+              (void) pthread_mutex_unlock (mutexes[i]);
+            }
+        }
+
+      (void) pthread_mutex_unlock (mutexes[park]);
+
+      if (result != EBUSY)
+        {
+          return (result);
+        }
+
+      park = busy;
+    }
+}
@@ -50,7 +50,8 @@
 
 
 static int
-pte_timed_eventwait (pte_osSemaphoreHandle event, const struct timespec *abstime)
+pte_timed_eventwait (pte_osSemaphoreHandle event, const struct timespec *abstime,
+                     const unsigned int *pRelTimeout, unsigned long long *pStart)
 /*
  * ------------------------------------------------------
  * DESCRIPTION
@@ -59,7 +60,13 @@ pte_timed_eventwait (pte_osSemaphoreHandle event, const struct timespec *abstime
  *      If abstime has passed when this routine is called then
  *      it returns a result to indicate this.
  *
- *      If 'abstime' is a NULL pointer then this function will
+ *      If 'pRelTimeout' is not NULL the timeout is instead
+ *      *pRelTimeout milliseconds from the first wait, whose time
+ *      is kept in *pStart (0 before the first wait). The first
+ *      wait passes it to the OS unchanged; later ones, after a
+ *      wakeup lost to another locker, wait for what is left.
+ *
+ *      If both are NULL then this function will
  *      block until it can successfully decrease the value or
  *      until interrupted by a signal.
  *
@@ -75,10 +82,27 @@ pte_timed_eventwait (pte_osSemaphoreHandle event, const struct timespec *abstime
 {
 
   unsigned int milliseconds;
+  unsigned long long elapsed;
   pte_osResult status;
   int retval;
 
-  if (abstime == NULL)
+  if (pRelTimeout != NULL)
+    {
+      if (*pStart == 0)
+        {
+          *pStart = pte_osClockGetNanoseconds ();
+          milliseconds = *pRelTimeout;
+        }
+      else
+        {
+          elapsed = (pte_osClockGetNanoseconds () - *pStart) / 1000000;
+          milliseconds = (elapsed >= *pRelTimeout) ?
+                         0 : *pRelTimeout - (unsigned int) elapsed;
+        }
+
+      status = pte_osSemaphorePend(event, &milliseconds);
+    }
+  else if (abstime == NULL)
     {
       status = pte_osSemaphorePend(event, NULL);
     }
@@ -107,12 +131,15 @@ pte_timed_eventwait (pte_osSemaphoreHandle event, const struct timespec *abstime
 }				/* pte_timed_semwait */
 
 
-int
-pthread_mutex_timedlock (pthread_mutex_t * mutex,
-                         const struct timespec *abstime)
+static int
+pte_mutex_timedlock (pthread_mutex_t * mutex,
+                     const struct timespec *abstime,
+                     const unsigned int *pRelTimeout)
 {
   int result;
   pthread_mutex_t mx;
+  pte_thread_t * waiter;
+  unsigned long long start = 0;
 
   /*
    * Let the system deal with invalid pointers.
@@ -138,13 +165,27 @@ pthread_mutex_timedlock (pthread_mutex_t * mutex,
     {
       if (PTE_ATOMIC_EXCHANGE(&mx->lock_idx,1) != 0)
         {
+          waiter = pte_waitBegin (PTE_WAIT_MUTEX, mx);
+
           while (PTE_ATOMIC_EXCHANGE(&mx->lock_idx,-1) != 0)
             {
-              if (0 != (result = pte_timed_eventwait (mx->handle, abstime)))
+              if (0 != (result = pte_timed_eventwait (mx->handle, abstime, pRelTimeout, &start)))
                 {
+                  pte_waitEnd (waiter);
                   return result;
                 }
             }
+
+          pte_waitEnd (waiter);
+          PTE_PROFILE_SAMPLE (waiter);
+
+          /* See pthread_mutex_lock(). */
+          if (waiter != NULL)
+            {
+              PTE_NORMAL_OWNER_SET (mx, waiter);
+            }
+
+          PTE_HOOK_LOCK_ACQUIRED (mx);
         }
     }
   else
@@ -171,19 +212,66 @@ pthread_mutex_timedlock (pthread_mutex_t * mutex,
             }
           else
             {
+              waiter = pte_waitBegin (PTE_WAIT_MUTEX, mx);
+
               while (PTE_ATOMIC_EXCHANGE(&mx->lock_idx,-1) != 0)
                 {
-                  if (0 != (result = pte_timed_eventwait (mx->handle, abstime)))
+                  if (0 != (result = pte_timed_eventwait (mx->handle, abstime, pRelTimeout, &start)))
                     {
+                      pte_waitEnd (waiter);
                       return result;
                     }
                 }
 
+              pte_waitEnd (waiter);
+              PTE_PROFILE_SAMPLE (waiter);
+
               mx->recursive_count = 1;
               mx->ownerThread = self;
+
+              PTE_HOOK_LOCK_ACQUIRED (mx);
             }
         }
     }
 
   return 0;
 }
+
+
+int
+pthread_mutex_timedlock (pthread_mutex_t * mutex,
+                         const struct timespec *abstime)
+{
+  return pte_mutex_timedlock (mutex, abstime, NULL);
+}
+
+
+int
+pthread_mutex_reltimedlock_np (pthread_mutex_t * mutex,
+                               const struct timespec *reltime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      As pthread_mutex_timedlock(), but the timeout is an
+ *      interval from now. It is passed to the OS as it is; the
+ *      clock is only read if the mutex has to be waited for.
+ *
+ * RESULTS
+ *              0               locked the mutex,
+ *              EINVAL          'reltime' is invalid,
+ *              EDEADLK         an error checking mutex is already
+ *                              held by the caller,
+ *              ETIMEDOUT       reltime elapsed first.
+ * ------------------------------------------------------
+ */
+{
+  unsigned int milliseconds;
+  int result;
+
+  if ((result = pte_reltimeout (reltime, &milliseconds)) != 0)
+    {
+      return result;
+    }
+
+  return pte_mutex_timedlock (mutex, NULL, &milliseconds);
+}
@@ -0,0 +1,68 @@
+/*
+ * pthread_mutex_trylock_normal_np.c
+ *
+ * Description:
+ * This translation unit implements mutual exclusion (mutex) primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_mutex_trylock_normal_np (pthread_mutex_t * mutex)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Tries to lock a PTHREAD_MUTEX_NORMAL mutex without
+ *      blocking.
+ *
+ * PARAMETERS
+ *      mutex
+ *              pointer to an instance of pthread_mutex_t
+ *
+ * DESCRIPTION
+ *      Equivalent to pthread_mutex_trylock() for a mutex
+ *      known to be of type PTHREAD_MUTEX_NORMAL, but does
+ *      not test the mutex kind. See
+ *      pthread_mutex_lock_normal_np().
+ *
+ * RESULTS
+ *              0               successfully locked,
+ *              EBUSY           the mutex is already locked,
+ *              EINVAL          'mutex' is invalid.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pthread_mutex_t mx = *mutex;
+
+  if (mx == NULL || mx >= PTHREAD_ERRORCHECK_MUTEX_INITIALIZER)
+    {
+      return pthread_mutex_trylock (mutex);
+    }
+
+  return PTE_ATOMIC_COMPARE_EXCHANGE (&mx->lock_idx, 1, 0) == 0 ? 0 : EBUSY;
+}
@@ -74,6 +74,9 @@ pthread_mutex_unlock (pthread_mutex_t * mutex)
         {
           int idx;
 
+          /* Only set if the lock was contended, see pthread_mutex_lock(). */
+          PTE_NORMAL_OWNER_CLEAR (mx);
+
           idx = PTE_ATOMIC_EXCHANGE (&mx->lock_idx,0);
           if (idx != 0)
             {
@@ -82,6 +85,9 @@ pthread_mutex_unlock (pthread_mutex_t * mutex)
                   /*
                    * Someone may be waiting on that mutex.
                    */
+                  PTE_TRACE_EVENT (PTE_TRACE_MUTEX_RELEASED, mx);
+                  PTE_HOOK_LOCK_RELEASED (mx);
+
                   if (pte_osSemaphorePost(mx->handle,1) != PTE_OS_OK)
                     {
                       result = EINVAL;
@@ -107,6 +113,9 @@ pthread_mutex_unlock (pthread_mutex_t * mutex)
 
                   if (PTE_ATOMIC_EXCHANGE (&mx->lock_idx,0) < 0)
                     {
+                      PTE_TRACE_EVENT (PTE_TRACE_MUTEX_RELEASED, mx);
+                      PTE_HOOK_LOCK_RELEASED (mx);
+
                       if (pte_osSemaphorePost(mx->handle,1) != PTE_OS_OK)
                         {
                           result = EINVAL;
@@ -0,0 +1,86 @@
+/*
+ * pthread_mutex_unlock_many_np.c
+ *
+ * Description:
+ * This translation unit implements mutual exclusion (mutex) primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_mutex_unlock_many_np (pthread_mutex_t * const * mutexes, int count)
+/*
+ * ------------------------------------------------------
+ * DESCRIPTION
+ *      Releases a set of mutexes previously acquired with
+ *      pthread_mutex_lock_many_np(). Mutexes that appear more
+ *      than once in the set are only unlocked once.
+ *
+ *      Every mutex is unlocked even if an earlier one fails;
+ *      the first error encountered is returned.
+ *
+ * RESULTS
+ *              0               all mutexes unlocked,
+ *              EINVAL          'mutexes' or an entry is invalid,
+ *              EPERM           a mutex is not owned by the caller.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int result = 0;
+  int i;
+
+  if (mutexes == NULL || count <= 0)
+    {
+      return EINVAL;
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      if (mutexes[i] == NULL)
+        {
+          return EINVAL;
+        }
+    }
+
+  for (i = pte_mutex_next_in_order (mutexes, count, -1);
+       i >= 0;
+       i = pte_mutex_next_in_order (mutexes, count, i))
+    {
+      int err = pthread_mutex_unlock (mutexes[i]);
+
+      if (result == 0)
+        {
+          result = err;
+        }
+    }
+
+  return (result);
+}
@@ -86,6 +86,7 @@ pthread_mutexattr_init (pthread_mutexattr_t * attr)
     {
       ma->pshared = PTHREAD_PROCESS_PRIVATE;
       ma->kind = PTHREAD_MUTEX_DEFAULT;
+      ma->wakeOrder = PTHREAD_WAKE_DEFAULT_NP;
     }
 
   *attr = ma;
@@ -0,0 +1,73 @@
+/*
+ * pthread_mutexattr_setwakeorder_np.c
+ *
+ * Description:
+ * This translation unit implements mutual exclusion (mutex) primitives.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+int
+pthread_mutexattr_setwakeorder_np (pthread_mutexattr_t * attr, int order)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Sets the order in which threads blocked on mutexes
+ *      created with 'attr' acquire them.
+ *
+ * PARAMETERS
+ *      attr
+ *              pointer to an instance of pthread_mutexattr_t
+ *
+ *      order
+ *              PTHREAD_WAKE_DEFAULT_NP
+ *                      whatever order the OS chooses (default)
+ *
+ *              PTHREAD_WAKE_PRIORITY_NP
+ *                      highest sched_priority first
+ *
+ * DESCRIPTION
+ *      Priority order is provided by the OS semaphore the mutex
+ *      blocks on. If the OS cannot order its waiters by priority,
+ *      pthread_mutex_init() fails with ENOTSUP.
+ *
+ * RESULTS
+ *              0               successfully set order,
+ *              EINVAL          'attr' or 'order' is invalid.
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (attr == NULL || *attr == NULL
+      || (order != PTHREAD_WAKE_DEFAULT_NP && order != PTHREAD_WAKE_PRIORITY_NP))
+    {
+      return EINVAL;
+    }
+
+  (*attr)->wakeOrder = order;
+
+  return 0;
+}
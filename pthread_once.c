@@ -40,27 +40,9 @@
  *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
  */
 
-#include "pte_osal.h"
 #include "pthread.h"
 #include "implement.h"
 
-#define PTE_ONCE_STARTED 1
-#define PTE_ONCE_INIT 0
-#define PTE_ONCE_DONE 2
-
-static void
-pte_once_init_routine_cleanup(void * arg)
-{
-  pthread_once_t * once_control = (pthread_once_t *) arg;
-
-  (void) PTE_ATOMIC_EXCHANGE(&once_control->state,PTE_ONCE_INIT);
-
-  if (PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
-    {
-      pte_osSemaphorePost((pte_osSemaphoreHandle) once_control->semaphore, 1);
-    }
-}
-
 int
 pthread_once (pthread_once_t * once_control, void (*init_routine) (void))
 /*
@@ -95,92 +77,17 @@ pthread_once (pthread_once_t * once_control, void (*init_routine) (void))
  *
  * RESULTS
  *              0               success,
- *              EINVAL          once_control or init_routine is NULL
+ *              EINVAL          once_control or init_routine is NULL,
+ *              other           the error pthread_once_result_np() kept
+ *                              for once_control
  *
  * ------------------------------------------------------
  */
 {
-  int result;
-  int state;
-  pte_osSemaphoreHandle sema;
-
   if (once_control == NULL || init_routine == NULL)
     {
-      result = EINVAL;
-      goto FAIL0;
-    }
-  else
-    {
-      result = 0;
-    }
-
-  while ((state =
-            PTE_ATOMIC_COMPARE_EXCHANGE(&once_control->state,
-                                        PTE_ONCE_STARTED,
-                                        PTE_ONCE_INIT))
-         != PTE_ONCE_DONE)
-    {
-      if (PTE_ONCE_INIT == state)
-        {
-
-
-          pthread_cleanup_push(pte_once_init_routine_cleanup, (void *) once_control);
-          (*init_routine)();
-          pthread_cleanup_pop(0);
-
-          (void) PTE_ATOMIC_EXCHANGE(&once_control->state,PTE_ONCE_DONE);
-
-          /*
-           * we didn't create the semaphore.
-           * it is only there if there is someone waiting.
-           */
-          if (PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
-            {
-              pte_osSemaphorePost((pte_osSemaphoreHandle) once_control->semaphore,once_control->numSemaphoreUsers);
-            }
-        }
-      else
-        {
-          PTE_ATOMIC_INCREMENT(&once_control->numSemaphoreUsers);
-
-          if (!PTE_ATOMIC_EXCHANGE_ADD((int*)&once_control->semaphore, 0L)) /* MBR fence */
-            {
-              pte_osSemaphoreCreate(0, (pte_osSemaphoreHandle*) &sema);
-
-              if (PTE_ATOMIC_COMPARE_EXCHANGE((int *) &once_control->semaphore,
-                                              (int) sema,
-                                              0))
-                {
-                  pte_osSemaphoreDelete((pte_osSemaphoreHandle)sema);
-                }
-            }
-
-          /*
-           * Check 'state' again in case the initting thread has finished or
-          * cancelled and left before seeing that there was a semaphore.
-           */
-          if (PTE_ATOMIC_EXCHANGE_ADD(&once_control->state, 0L) == PTE_ONCE_STARTED)
-            {
-              pte_osSemaphorePend((pte_osSemaphoreHandle) once_control->semaphore,NULL);
-            }
-
-          if (0 == PTE_ATOMIC_DECREMENT(&once_control->numSemaphoreUsers))
-            {
-              /* we were last */
-              if ((sema =
-                     (pte_osSemaphoreHandle) PTE_ATOMIC_EXCHANGE((int *) &once_control->semaphore,0)))
-                {
-                  pte_osSemaphoreDelete(sema);
-                }
-            }
-        }
+      return EINVAL;
     }
 
-  /*
-   * ------------
-   * Failure Code
-   * ------------
-   */
-FAIL0:
-  return (result);
+  return pte_once (once_control, init_routine, NULL, NULL, PTE_FALSE);
 }                               /* pthread_once */
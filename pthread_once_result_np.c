@@ -0,0 +1,79 @@
+/*
+ * pthread_once_result_np.c
+ *
+ * Description:
+ * This translation unit implements miscellaneous thread functions.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+int
+pthread_once_result_np (pthread_once_t * once_control,
+                        int (*init_routine) (void),
+                        const struct timespec * abstime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      As pthread_once_timed_np(), for an init_routine that
+ *      returns 0 on success or an error number.
+ *
+ * PARAMETERS
+ *      once_control
+ *              pointer to an instance of pthread_once_t
+ *
+ *      init_routine
+ *              pointer to an initialization routine
+ *
+ *      abstime
+ *              time at which to stop waiting, or NULL to
+ *              wait indefinitely
+ *
+ * DESCRIPTION
+ *      init_routine runs once whether it succeeds or fails.
+ *      Its result is kept in once_control and returned by
+ *      this and every later call, so all callers see the
+ *      failure and none of them retries it.
+ *
+ *      The wait is a cancellation point. If init_routine is
+ *      cancelled, it has not run, as for pthread_once().
+ *
+ * RESULTS
+ *              0               success,
+ *              EINVAL          once_control or init_routine is NULL,
+ *              ETIMEDOUT       init_routine was still running at
+ *                              'abstime',
+ *              other           the error init_routine returned
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (once_control == NULL || init_routine == NULL)
+    {
+      return EINVAL;
+    }
+
+  return pte_once (once_control, NULL, init_routine, abstime, PTE_TRUE);
+}
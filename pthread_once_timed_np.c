@@ -0,0 +1,80 @@
+/*
+ * pthread_once_timed_np.c
+ *
+ * Description:
+ * This translation unit implements miscellaneous thread functions.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+int
+pthread_once_timed_np (pthread_once_t * once_control,
+                       void (*init_routine) (void),
+                       const struct timespec * abstime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      As pthread_once(), but a thread that finds another
+ *      thread running init_routine waits for it only until
+ *      'abstime'.
+ *
+ * PARAMETERS
+ *      once_control
+ *              pointer to an instance of pthread_once_t
+ *
+ *      init_routine
+ *              pointer to an initialization routine
+ *
+ *      abstime
+ *              time at which to stop waiting, or NULL to
+ *              wait indefinitely
+ *
+ * DESCRIPTION
+ *      An init_routine that never returns, e.g. because it
+ *      waits on I/O, would otherwise block every later caller
+ *      forever. A caller that times out has not run
+ *      init_routine and may call again.
+ *
+ *      The wait is a cancellation point.
+ *
+ * RESULTS
+ *              0               success,
+ *              EINVAL          once_control or init_routine is NULL,
+ *              ETIMEDOUT       init_routine was still running at
+ *                              'abstime',
+ *              other           the error pthread_once_result_np() kept
+ *                              for once_control
+ *
+ * ------------------------------------------------------
+ */
+{
+  if (once_control == NULL || init_routine == NULL)
+    {
+      return EINVAL;
+    }
+
+  return pte_once (once_control, init_routine, NULL, abstime, PTE_TRUE);
+}
@@ -0,0 +1,107 @@
+/*
+ * pthread_profile_enable_np.c
+ *
+ * Description:
+ * Starts or stops sampling of contended mutex and rwlock locks.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_profile_enable_np (int period)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Starts or stops recording the call sites of
+ *      contended mutex and read-write lock locks.
+ *
+ * PARAMETERS
+ *      period
+ *              sample every period'th contended lock on each
+ *              thread, or zero to stop sampling.
+ *
+ * DESCRIPTION
+ *      Each sample adds the time the thread waited for the
+ *      lock to the entry for the address the lock function
+ *      was called from; pthread_profile_top_np() reports the
+ *      entries. Only POSIX threads are sampled, and only
+ *      pthread_mutex_lock(), pthread_mutex_timedlock() and
+ *      the pthread_rwlock_*lock() functions that had to
+ *      block.
+ *
+ *      Starting while stopped discards the samples of the
+ *      previous run; changing the period of a running
+ *      profile keeps them. While stopped the only cost is a
+ *      test of the period on the contended paths.
+ *
+ *      Before discarding, the call waits for threads still
+ *      adding a sample from the previous run. Calls to this
+ *      function itself must not overlap; two threads
+ *      starting the profile at once may each reset the table
+ *      while the other's samples are being taken.
+ *
+ * RESULTS
+ *              0               successfully changed,
+ *              EINVAL          'period' is negative.
+ *
+ * ------------------------------------------------------
+ */
+{
+  int i;
+
+  if (period < 0)
+    {
+      return EINVAL;
+    }
+
+  if (period != 0 && pte_profilePeriod == 0)
+    {
+      /*
+       * Samplers re-check the period once counted in, so none can
+       * start on the table until the exchange below.
+       */
+      while (PTE_ATOMIC_EXCHANGE_ADD (&pte_profileActive, 0) != 0)
+        {
+          pte_osThreadSleep (1);
+        }
+
+      for (i = 0; i < PTE_PROFILE_SITES; i++)
+        {
+          pte_profileSites[i].state = 0;
+          pte_profileSites[i].site = NULL;
+          pte_profileSites[i].samples = 0;
+          pte_profileSites[i].totalWaitUs = 0;
+          pte_profileSites[i].maxWaitUs = 0;
+        }
+
+      pte_profileDropped = 0;
+    }
+
+  (void) PTE_ATOMIC_EXCHANGE (&pte_profilePeriod, period);
+
+  return 0;
+}
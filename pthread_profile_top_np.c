@@ -0,0 +1,143 @@
+/*
+ * pthread_profile_top_np.c
+ *
+ * Description:
+ * Reports the most contended mutex and rwlock call sites.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_profile_top_np (pthread_profile_site_np_t * sites,
+                        int * count, int * dropped)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Returns the call sites that have spent the most
+ *      sampled time waiting for a lock.
+ *
+ * PARAMETERS
+ *      sites
+ *              array to receive the entries, most total wait
+ *              first.
+ *
+ *      count
+ *              on entry the size of 'sites'; on return the
+ *              number of entries written.
+ *
+ *      dropped
+ *              optional; receives the number of samples lost
+ *              because the table of sites was full.
+ *
+ * DESCRIPTION
+ *      Entries are read without stopping the profile, so a
+ *      sample taken during the call may be partly counted.
+ *      The table holds PTE_PROFILE_SITES call sites.
+ *
+ * RESULTS
+ *              0               successfully reported,
+ *              EINVAL          'sites' or 'count' is invalid.
+ *
+ * ------------------------------------------------------
+ */
+{
+  pte_profile_site_t * entry;
+  pthread_profile_site_np_t site;
+  int n = 0;
+  int i, j;
+
+  if (sites == NULL || count == NULL || *count < 0)
+    {
+      return EINVAL;
+    }
+
+  for (i = 0; i < PTE_PROFILE_SITES; i++)
+    {
+      entry = &pte_profileSites[i];
+
+      if (entry->state != 2 || entry->samples == 0)
+        {
+          continue;
+        }
+
+      site.site = entry->site;
+      site.samples = entry->samples;
+      site.totalWaitUs = entry->totalWaitUs;
+      site.maxWaitUs = entry->maxWaitUs;
+
+      /* Merge a site that raced its way into a second slot. */
+      for (j = 0; j < n; j++)
+        {
+          if (sites[j].site == site.site)
+            {
+              break;
+            }
+        }
+
+      if (j < n)
+        {
+          site.samples += sites[j].samples;
+          site.totalWaitUs = site.totalWaitUs > 0x7fffffff - sites[j].totalWaitUs ?
+                             0x7fffffff : site.totalWaitUs + sites[j].totalWaitUs;
+          site.maxWaitUs = PTE_MAX (site.maxWaitUs, sites[j].maxWaitUs);
+
+          /* Close the gap; the entry is reinserted below. */
+          for (n--; j < n; j++)
+            {
+              sites[j] = sites[j + 1];
+            }
+        }
+
+      /* Insertion sort on total wait, keeping the top *count. */
+      for (j = n; j > 0 && sites[j - 1].totalWaitUs < site.totalWaitUs; j--)
+        {
+          if (j < *count)
+            {
+              sites[j] = sites[j - 1];
+            }
+        }
+
+      if (j < *count)
+        {
+          sites[j] = site;
+
+          if (n < *count)
+            {
+              n++;
+            }
+        }
+    }
+
+  *count = n;
+
+  if (dropped != NULL)
+    {
+      *dropped = pte_profileDropped;
+    }
+
+  return 0;
+}
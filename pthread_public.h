@@ -260,6 +260,12 @@ typedef unsigned int pthread_t_;
 
 #define PTHREAD_RWLOCK_INITIALIZER _PTHREAD_RWLOCK_INITIALIZER
 
+    /*
+     * Barrier for 'count' threads, created on first use.
+     */
+#define PTHREAD_BARRIER_INITIALIZER_NP(count) \
+  ((pthread_barrier_t) (((unsigned long) (count) << 1) | 1))
+
     typedef struct pte_cleanup_t pte_cleanup_t;
 
     typedef void (*  pte_cleanup_callback_t)(void *);
@@ -488,6 +494,14 @@ extern "C" {
     int  pthread_once (pthread_once_t * once_control,
                        void (*init_routine) (void));
 
+    int  pthread_once_timed_np (pthread_once_t * once_control,
+                                void (*init_routine) (void),
+                                const struct timespec * abstime);
+
+    int  pthread_once_result_np (pthread_once_t * once_control,
+                                 int (*init_routine) (void),
+                                 const struct timespec * abstime);
+
     int  pthread_atfork(void (*prepare)(void),
                        void (*parent)(void),
                        void (*child)(void));
@@ -631,6 +645,14 @@ extern "C" {
 
     int  pthread_getconcurrency (void);
 
+    /*
+     * CPU-time clocks. pthread_getcpuclockid() only returns a clock
+     * for the calling thread (CLOCK_THREAD_CPUTIME_ID), and only
+     * where <time.h> defines it; use pthread_getcputime_np() to read
+     * the CPU time of other threads.
+     */
+    int  pthread_getcpuclockid (pthread_t thread, clockid_t * clock_id);
+
     /*
      * Read-Write Lock Functions
      */
@@ -687,6 +709,140 @@ extern "C" {
     int  pthread_mutexattr_getkind_np(pthread_mutexattr_t * attr,
                                       int *kind);
 
+    /*
+     * Acquire or release a set of mutexes without risk of
+     * lock-order deadlock.
+     */
+    int  pthread_mutex_lock_many_np (pthread_mutex_t * const * mutexes,
+                                     int count);
+    int  pthread_mutex_unlock_many_np (pthread_mutex_t * const * mutexes,
+                                       int count);
+
+    /*
+     * Lock operations for mutexes known to be PTHREAD_MUTEX_NORMAL,
+     * without the per-call kind tests.
+     */
+    int  pthread_mutex_lock_normal_np (pthread_mutex_t * mutex);
+    int  pthread_mutex_trylock_normal_np (pthread_mutex_t * mutex);
+    int  pthread_mutex_unlock_normal_np (pthread_mutex_t * mutex);
+
+    /*
+     * Timed waits with a timeout relative to now rather than an
+     * absolute time; see also sem_reltimedwait_np().
+     */
+    int  pthread_mutex_reltimedlock_np (pthread_mutex_t * mutex,
+                                        const struct timespec * reltime);
+    int  pthread_cond_timedwait_relative_np (pthread_cond_t * cond,
+                                             pthread_mutex_t * mutex,
+                                             const struct timespec * reltime);
+
+    /*
+     * Order in which blocked threads are woken. For semaphores
+     * see sem_init_np().
+     */
+    enum
+    {
+      PTHREAD_WAKE_DEFAULT_NP = 0,	/* Whatever order the OS chooses */
+      PTHREAD_WAKE_PRIORITY_NP = 1	/* Highest sched_priority first */
+    };
+
+    int  pthread_mutexattr_setwakeorder_np (pthread_mutexattr_t * attr,
+                                            int order);
+    int  pthread_mutexattr_getwakeorder_np (const pthread_mutexattr_t * attr,
+                                            int *order);
+    int  pthread_condattr_setwakeorder_np (pthread_condattr_t * attr,
+                                           int order);
+    int  pthread_condattr_getwakeorder_np (const pthread_condattr_t * attr,
+                                           int *order);
+
+    /*
+     * Synchronisation event tracing. Returns ENOSYS unless the
+     * library was built with PTE_TRACE.
+     */
+    int  pthread_trace_enable_np (int enable);
+    int  pthread_trace_export_np (void (*write) (const char * text, void * arg),
+                                  void * arg);
+
+    /*
+     * Library statistics. Returns ENOSYS unless the library was
+     * built with PTE_STATS.
+     */
+    typedef struct pthread_stats_np_t_
+      {
+        /* Current values, not cleared by pthread_resetstats_np() */
+        int osSemaphores;         /* OS semaphores allocated */
+        int osMutexes;            /* OS mutexes allocated */
+        int osThreads;            /* OS threads allocated */
+        int osTlsKeys;            /* OS TLS slots allocated */
+        int reuseDepth;           /* Thread structs on the reuse queue */
+
+        /* Totals since start-up or the last reset */
+        int osSemaphoresCreated;
+        int osMutexesCreated;
+        int osThreadsCreated;
+        int threadsReused;        /* Creates served from the reuse queue */
+        int mutexLazyInits;       /* Statically initialised objects */
+        int condLazyInits;        /* reaching their lazy-init path */
+        int rwlockLazyInits;
+        int spinLazyInits;
+        int semLazyInits;
+        int barrierLazyInits;
+      } pthread_stats_np_t;
+
+    int  pthread_getstats_np (pthread_stats_np_t * stats);
+    int  pthread_resetstats_np (void);
+
+    /*
+     * Report what each thread is blocked on and any mutex
+     * deadlocks. Returns EDEADLK if a deadlock was found.
+     */
+    int  pthread_dump_waits_np (void (*write) (const char * text, void * arg),
+                                void * arg);
+
+    /*
+     * Instrumentation hooks. Returns ENOSYS unless the library
+     * was built with PTE_HOOKS. 'kind' is one of the
+     * PTHREAD_HOOK_*_NP values below; for PTHREAD_HOOK_JOIN_NP
+     * 'object' is the thread being joined.
+     */
+    enum
+    {
+      PTHREAD_HOOK_MUTEX_NP = 1,
+      PTHREAD_HOOK_COND_NP,
+      PTHREAD_HOOK_SEM_NP,
+      PTHREAD_HOOK_RWLOCK_NP,
+      PTHREAD_HOOK_BARRIER_NP,
+      PTHREAD_HOOK_JOIN_NP
+    };
+
+    typedef struct pthread_hooks_np_t_
+      {
+        void (*before_block) (int kind, void * object);
+        void (*after_wake) (int kind, void * object);
+        void (*lock_acquired) (void * mutex);   /* After blocking */
+        void (*lock_released) (void * mutex);   /* May have waiters */
+        void (*thread_start) (pthread_t thread);
+        void (*thread_exit) (pthread_t thread);
+      } pthread_hooks_np_t;
+
+    int  pthread_sethooks_np (const pthread_hooks_np_t * hooks);
+
+    /*
+     * Contention sampling. Records every 'period'th contended
+     * mutex or rwlock lock per thread by call site.
+     */
+    typedef struct pthread_profile_site_np_t_
+      {
+        void * site;              /* Return address of the lock call */
+        int samples;
+        int totalWaitUs;          /* Sampled waits only, saturates at INT_MAX */
+        int maxWaitUs;
+      } pthread_profile_site_np_t;
+
+    int  pthread_profile_enable_np (int period);
+    int  pthread_profile_top_np (pthread_profile_site_np_t * sites,
+                                 int * count, int * dropped);
+
     /*
      * Possibly supported by other POSIX threads implementations
      */
@@ -698,6 +854,8 @@ extern "C" {
     int pthread_getaffinity_np(pthread_t thread, size_t cpusetsize,
                                   cpu_set_t *cpuset);
 
+    int  pthread_getcputime_np (pthread_t thread, struct timespec * cputime);
+
     /*
      * Register a system time change with the library.
      * Causes the library to perform various functions
@@ -718,6 +876,126 @@ extern "C" {
 #endif
 #define _GTHREAD_USE_MUTEX_INIT_FUNC 1
 
+#if defined(PTHREAD_INLINE_FAST_PATHS_NP) || defined(PTE_INTERNAL)
+    /*
+     * Leading members of the library's mutex and spinlock
+     * structures, relied on by the inline fast paths below.
+     * implement.h checks that they match.
+     */
+    struct pte_mutex_head_np_t_
+      {
+        int lock_idx;
+        int kind;
+      };
+
+    struct pte_spinlock_head_np_t_
+      {
+        int interlock;
+      };
+
+#define PTE_SPIN_UNLOCKED    (1)
+#define PTE_SPIN_LOCKED      (2)
+#define PTE_SPIN_USE_MUTEX   (3)
+#endif
+
+#if defined(PTHREAD_INLINE_FAST_PATHS_NP) && defined(__GNUC__)
+    /*
+     * Define PTHREAD_INLINE_FAST_PATHS_NP before including
+     * pthread.h to lock and unlock uncontended NORMAL mutexes
+     * and spinlocks inline, without calling into the library
+     * (through an import stub when it is used as pthread.suprx).
+     * Contention, statically initialised objects and other
+     * mutex kinds still go to the exported functions.
+     */
+    static __inline__ int
+    pte_mutex_lock_inline_np (pthread_mutex_t * mutex)
+    {
+      struct pte_mutex_head_np_t_ * mx = (struct pte_mutex_head_np_t_ *) *mutex;
+      int unlocked = 0;
+
+      if (mx != NULL
+          && *mutex < PTHREAD_ERRORCHECK_MUTEX_INITIALIZER
+          && mx->kind == PTHREAD_MUTEX_NORMAL
+          && __atomic_compare_exchange_n (&mx->lock_idx, &unlocked, 1, 0,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+          return 0;
+        }
+
+      return (pthread_mutex_lock) (mutex);
+    }
+
+    static __inline__ int
+    pte_mutex_unlock_inline_np (pthread_mutex_t * mutex)
+    {
+      struct pte_mutex_head_np_t_ * mx = (struct pte_mutex_head_np_t_ *) *mutex;
+      int locked = 1;
+
+      /* A lock_idx of -1 (possible waiters) takes the slow path. */
+      if (mx != NULL
+          && *mutex < PTHREAD_ERRORCHECK_MUTEX_INITIALIZER
+          && mx->kind == PTHREAD_MUTEX_NORMAL
+          && __atomic_compare_exchange_n (&mx->lock_idx, &locked, 0, 0,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+          return 0;
+        }
+
+      return (pthread_mutex_unlock) (mutex);
+    }
+
+    static __inline__ int
+    pte_spin_lock_inline_np (pthread_spinlock_t * lock)
+    {
+      struct pte_spinlock_head_np_t_ * s;
+      int unlocked = PTE_SPIN_UNLOCKED;
+
+      if (lock != NULL
+          && *lock != NULL
+          && *lock != PTHREAD_SPINLOCK_INITIALIZER)
+        {
+          s = (struct pte_spinlock_head_np_t_ *) *lock;
+
+          if (__atomic_compare_exchange_n (&s->interlock, &unlocked,
+                                           PTE_SPIN_LOCKED, 0,
+                                           __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+              return 0;
+            }
+        }
+
+      return (pthread_spin_lock) (lock);
+    }
+
+    static __inline__ int
+    pte_spin_unlock_inline_np (pthread_spinlock_t * lock)
+    {
+      struct pte_spinlock_head_np_t_ * s;
+      int locked = PTE_SPIN_LOCKED;
+
+      if (lock != NULL
+          && *lock != NULL
+          && *lock != PTHREAD_SPINLOCK_INITIALIZER)
+        {
+          s = (struct pte_spinlock_head_np_t_ *) *lock;
+
+          if (__atomic_compare_exchange_n (&s->interlock, &locked,
+                                           PTE_SPIN_UNLOCKED, 0,
+                                           __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            {
+              return 0;
+            }
+        }
+
+      return (pthread_spin_unlock) (lock);
+    }
+
+#define pthread_mutex_lock(mutex) pte_mutex_lock_inline_np (mutex)
+#define pthread_mutex_unlock(mutex) pte_mutex_unlock_inline_np (mutex)
+#define pthread_spin_lock(lock) pte_spin_lock_inline_np (lock)
+#define pthread_spin_unlock(lock) pte_spin_unlock_inline_np (lock)
+#endif /* PTHREAD_INLINE_FAST_PATHS_NP */
+
 #ifdef __cplusplus
 }
 #endif
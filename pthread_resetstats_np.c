@@ -1,8 +1,8 @@
 /*
- * pte_rwlock_cancelwrwait.c
+ * pthread_resetstats_np.c
  *
  * Description:
- * This translation unit implements read/write lock primitives.
+ * Clears the library statistics totals.
  *
  * --------------------------------------------------------------------------
  *
@@ -11,19 +11,6 @@
  *
  *      Contact Email: jschmidlapp@users.sourceforge.net
  *
- *
- *      Based upon Pthreads-win32 - POSIX Threads Library for Win32
- *      Copyright(C) 1998 John E. Bossom
- *      Copyright(C) 1999,2005 Pthreads-win32 contributors
- *
- *      Contact Email: rpj@callisto.canberra.edu.au
- *
- *      The original list of contributors to the Pthreads-win32 project
- *      is contained in the file CONTRIBUTORS.ptw32 included with the
- *      source code distribution. The list can also be seen at the
- *      following World Wide Web location:
- *      http://sources.redhat.com/pthreads-win32/contributors.html
- *
  *      This library is free software; you can redistribute it and/or
  *      modify it under the terms of the GNU Lesser General Public
  *      License as published by the Free Software Foundation; either
@@ -43,14 +30,38 @@
 #include "pthread.h"
 #include "implement.h"
 
-void
-pte_rwlock_cancelwrwait (void *arg)
+
+int
+pthread_resetstats_np (void)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Sets the statistics totals back to zero.
+ *
+ * DESCRIPTION
+ *      Only the totals (the ...Created, ...Reused and
+ *      ...LazyInits fields of pthread_stats_np_t) are
+ *      cleared. Current values such as the number of OS
+ *      semaphores allocated are left alone, since they
+ *      track objects that still exist.
+ *
+ * RESULTS
+ *              0               successfully reset,
+ *              ENOSYS          statistics not built in.
+ *
+ * ------------------------------------------------------
+ */
 {
-  pthread_rwlock_t rwl = (pthread_rwlock_t) arg;
+#ifdef PTE_STATS
+  int i;
 
-  rwl->nSharedAccessCount = -rwl->nCompletedSharedAccessCount;
-  rwl->nCompletedSharedAccessCount = 0;
+  for (i = PTE_STAT_FIRST_COUNTER; i < PTE_STAT_COUNT; i++)
+    {
+      (void) PTE_ATOMIC_EXCHANGE (&pte_stats[i], 0);
+    }
 
-  (void) pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted));
-  (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
+  return 0;
+#else
+  return ENOSYS;
+#endif
 }
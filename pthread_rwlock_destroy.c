@@ -51,7 +51,7 @@ int
 pthread_rwlock_destroy (pthread_rwlock_t * rwlock)
 {
   pthread_rwlock_t rwl;
-  int result = 0, result1 = 0, result2 = 0;
+  int result = 0;
 
   if (rwlock == NULL || *rwlock == NULL)
     {
@@ -67,52 +67,27 @@ pthread_rwlock_destroy (pthread_rwlock_t * rwlock)
           return EINVAL;
         }
 
-      if ((result = pthread_mutex_lock (&(rwl->mtxExclusiveAccess))) != 0)
-        {
-          return result;
-        }
-
-      if ((result =
-             pthread_mutex_lock (&(rwl->mtxSharedAccessCompleted))) != 0)
-        {
-          (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          return result;
-        }
-
       /*
-       * Check whether any threads own/wait for the lock (wait for ex.access);
-       * report "BUSY" if so.
+       * Check whether any threads own/wait for the lock;
+       * report "BUSY" if so. A thread still on its way out of
+       * pte_rwlock_wake() holds queueLock, so take it to let
+       * that finish.
        */
-      if (rwl->nExclusiveAccessCount > 0
-          || rwl->nSharedAccessCount > rwl->nCompletedSharedAccessCount)
-        {
-          result = pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted));
-          result1 = pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          result2 = EBUSY;
-        }
-      else
+      pte_osMutexLock (rwl->queueLock);
+
+      if (rwl->state != 0)
         {
-          rwl->nMagic = 0;
-
-          if ((result =
-                 pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted))) != 0)
-            {
-              pthread_mutex_unlock (&rwl->mtxExclusiveAccess);
-              return result;
-            }
-
-          if ((result =
-                 pthread_mutex_unlock (&(rwl->mtxExclusiveAccess))) != 0)
-            {
-              return result;
-            }
-
-          *rwlock = NULL;	/* Invalidate rwlock before anything else */
-          result = pthread_cond_destroy (&(rwl->cndSharedAccessCompleted));
-          result1 = pthread_mutex_destroy (&(rwl->mtxSharedAccessCompleted));
-          result2 = pthread_mutex_destroy (&(rwl->mtxExclusiveAccess));
-          (void) free (rwl);
+          pte_osMutexUnlock (rwl->queueLock);
+          return EBUSY;
         }
+
+      rwl->nMagic = 0;
+      *rwlock = NULL;	/* Invalidate rwlock before anything else */
+
+      pte_osMutexUnlock (rwl->queueLock);
+
+      (void) pte_osMutexDelete (rwl->queueLock);
+      (void) free (rwl);
     }
   else
     {
@@ -148,5 +123,5 @@ pthread_rwlock_destroy (pthread_rwlock_t * rwlock)
 
     }
 
-  return ((result != 0) ? result : ((result1 != 0) ? result1 : result2));
+  return result;
 }
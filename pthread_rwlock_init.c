@@ -73,39 +73,20 @@ pthread_rwlock_init (pthread_rwlock_t * rwlock,
       goto DONE;
     }
 
-  rwl->nSharedAccessCount = 0;
-  rwl->nExclusiveAccessCount = 0;
-  rwl->nCompletedSharedAccessCount = 0;
+  rwl->state = 0;
+  rwl->waiters = NULL;
 
-  result = pthread_mutex_init (&rwl->mtxExclusiveAccess, NULL);
-  if (result != 0)
+  if (pte_osMutexCreate (&rwl->queueLock) != PTE_OS_OK)
     {
+      result = EAGAIN;
       goto FAIL0;
     }
 
-  result = pthread_mutex_init (&rwl->mtxSharedAccessCompleted, NULL);
-  if (result != 0)
-    {
-      goto FAIL1;
-    }
-
-  result = pthread_cond_init (&rwl->cndSharedAccessCompleted, NULL);
-  if (result != 0)
-    {
-      goto FAIL2;
-    }
-
   rwl->nMagic = PTE_RWLOCK_MAGIC;
 
   result = 0;
   goto DONE;
 
-FAIL2:
-  (void) pthread_mutex_destroy (&(rwl->mtxSharedAccessCompleted));
-
-FAIL1:
-  (void) pthread_mutex_destroy (&(rwl->mtxExclusiveAccess));
-
 FAIL0:
   (void) free (rwl);
   rwl = NULL;
@@ -51,6 +51,8 @@ pthread_rwlock_rdlock (pthread_rwlock_t * rwlock)
 {
   int result;
   pthread_rwlock_t rwl;
+  pte_thread_t * waiter;
+  int s;
 
   if (rwlock == NULL || *rwlock == NULL)
     {
@@ -80,30 +82,23 @@ pthread_rwlock_rdlock (pthread_rwlock_t * rwlock)
       return EINVAL;
     }
 
-  if ((result = pthread_mutex_lock (&(rwl->mtxExclusiveAccess))) != 0)
-    {
-      return result;
-    }
+  s = rwl->state;
 
-  if (++rwl->nSharedAccessCount == INT_MAX)
+  if (!(s & (PTE_RWLOCK_WRITER | PTE_RWLOCK_WAITERS))
+      && (s & PTE_RWLOCK_READERS) != PTE_RWLOCK_READERS
+      && PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state, s + 1, s) == s)
     {
-      if ((result =
-             pthread_mutex_lock (&(rwl->mtxSharedAccessCompleted))) != 0)
-        {
-          (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          return result;
-        }
+      return 0;
+    }
 
-      rwl->nSharedAccessCount -= rwl->nCompletedSharedAccessCount;
-      rwl->nCompletedSharedAccessCount = 0;
+  waiter = pte_waitBegin (PTE_WAIT_RWLOCK, rwl);
+  result = pte_rwlock_wait (rwl, PTE_FALSE, NULL);
+  pte_waitEnd (waiter);
 
-      if ((result =
-             pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted))) != 0)
-        {
-          (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          return result;
-        }
+  if (result == 0)
+    {
+      PTE_PROFILE_SAMPLE (waiter);
     }
 
-  return (pthread_mutex_unlock (&(rwl->mtxExclusiveAccess)));
+  return result;
 }
@@ -52,6 +52,8 @@ pthread_rwlock_timedrdlock (pthread_rwlock_t * rwlock,
 {
   int result;
   pthread_rwlock_t rwl;
+  pte_thread_t * waiter;
+  int s;
 
   if (rwlock == NULL || *rwlock == NULL)
     {
@@ -81,36 +83,23 @@ pthread_rwlock_timedrdlock (pthread_rwlock_t * rwlock,
       return EINVAL;
     }
 
-  if ((result =
-         pthread_mutex_timedlock (&(rwl->mtxExclusiveAccess), abstime)) != 0)
-    {
-      return result;
-    }
+  s = rwl->state;
 
-  if (++rwl->nSharedAccessCount == INT_MAX)
+  if (!(s & (PTE_RWLOCK_WRITER | PTE_RWLOCK_WAITERS))
+      && (s & PTE_RWLOCK_READERS) != PTE_RWLOCK_READERS
+      && PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state, s + 1, s) == s)
     {
-      if ((result =
-             pthread_mutex_timedlock (&(rwl->mtxSharedAccessCompleted),
-                                      abstime)) != 0)
-        {
-          if (result == ETIMEDOUT)
-            {
-              ++rwl->nCompletedSharedAccessCount;
-            }
-          (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          return result;
-        }
+      return 0;
+    }
 
-      rwl->nSharedAccessCount -= rwl->nCompletedSharedAccessCount;
-      rwl->nCompletedSharedAccessCount = 0;
+  waiter = pte_waitBegin (PTE_WAIT_RWLOCK, rwl);
+  result = pte_rwlock_wait (rwl, PTE_FALSE, abstime);
+  pte_waitEnd (waiter);
 
-      if ((result =
-             pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted))) != 0)
-        {
-          (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          return result;
-        }
+  if (result == 0)
+    {
+      PTE_PROFILE_SAMPLE (waiter);
     }
 
-  return (pthread_mutex_unlock (&(rwl->mtxExclusiveAccess)));
+  return result;
 }
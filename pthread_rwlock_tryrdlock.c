@@ -50,6 +50,7 @@ int
 pthread_rwlock_tryrdlock (pthread_rwlock_t * rwlock)
 {
   int result;
+  int s;
   pthread_rwlock_t rwl;
 
   if (rwlock == NULL || *rwlock == NULL)
@@ -80,30 +81,21 @@ pthread_rwlock_tryrdlock (pthread_rwlock_t * rwlock)
       return EINVAL;
     }
 
-  if ((result = pthread_mutex_trylock (&(rwl->mtxExclusiveAccess))) != 0)
+  do
     {
-      return result;
-    }
+      s = rwl->state;
 
-  if (++rwl->nSharedAccessCount == INT_MAX)
-    {
-      if ((result =
-             pthread_mutex_lock (&(rwl->mtxSharedAccessCompleted))) != 0)
+      if (s & (PTE_RWLOCK_WRITER | PTE_RWLOCK_WAITERS))
         {
-          (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          return result;
+          return EBUSY;
         }
 
-      rwl->nSharedAccessCount -= rwl->nCompletedSharedAccessCount;
-      rwl->nCompletedSharedAccessCount = 0;
-
-      if ((result =
-             pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted))) != 0)
+      if ((s & PTE_RWLOCK_READERS) == PTE_RWLOCK_READERS)
         {
-          (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-          return result;
+          return EAGAIN;
         }
     }
+  while (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state, s + 1, s) != s);
 
-  return (pthread_mutex_unlock (&rwl->mtxExclusiveAccess));
+  return 0;
 }
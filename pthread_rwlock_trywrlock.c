@@ -49,7 +49,7 @@
 int
 pthread_rwlock_trywrlock (pthread_rwlock_t * rwlock)
 {
-  int result, result1;
+  int result;
   pthread_rwlock_t rwl;
 
   if (rwlock == NULL || *rwlock == NULL)
@@ -80,50 +80,11 @@ pthread_rwlock_trywrlock (pthread_rwlock_t * rwlock)
       return EINVAL;
     }
 
-  if ((result = pthread_mutex_trylock (&(rwl->mtxExclusiveAccess))) != 0)
+  if (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state,
+                                   PTE_RWLOCK_WRITER, 0) != 0)
     {
-      return result;
+      return EBUSY;
     }
 
-  if ((result =
-         pthread_mutex_trylock (&(rwl->mtxSharedAccessCompleted))) != 0)
-    {
-      result1 = pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-      return ((result1 != 0) ? result1 : result);
-    }
-
-  if (rwl->nExclusiveAccessCount == 0)
-    {
-      if (rwl->nCompletedSharedAccessCount > 0)
-        {
-          rwl->nSharedAccessCount -= rwl->nCompletedSharedAccessCount;
-          rwl->nCompletedSharedAccessCount = 0;
-        }
-
-      if (rwl->nSharedAccessCount > 0)
-        {
-          if ((result =
-                 pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted))) != 0)
-            {
-              (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-              return result;
-            }
-
-          if ((result =
-                 pthread_mutex_unlock (&(rwl->mtxExclusiveAccess))) == 0)
-            {
-              result = EBUSY;
-            }
-        }
-      else
-        {
-          rwl->nExclusiveAccessCount = 1;
-        }
-    }
-  else
-    {
-      result = EBUSY;
-    }
-
-  return result;
+  return 0;
 }
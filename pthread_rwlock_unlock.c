@@ -49,7 +49,8 @@
 int
 pthread_rwlock_unlock (pthread_rwlock_t * rwlock)
 {
-  int result, result1;
+  int s;
+  int n;
   pthread_rwlock_t rwl;
 
   if (rwlock == NULL || *rwlock == NULL)
@@ -72,29 +73,33 @@ pthread_rwlock_unlock (pthread_rwlock_t * rwlock)
       return EINVAL;
     }
 
-  if (rwl->nExclusiveAccessCount == 0)
+  /*
+   * A writer clears PTE_RWLOCK_WRITER, a reader drops its count. If
+   * that leaves the lock free with threads queued, hand it on.
+   */
+  do
     {
-      if ((result =
-             pthread_mutex_lock (&(rwl->mtxSharedAccessCompleted))) != 0)
+      s = rwl->state;
+
+      if (s & PTE_RWLOCK_WRITER)
         {
-          return result;
+          n = s & ~PTE_RWLOCK_WRITER;
         }
-
-      if (++rwl->nCompletedSharedAccessCount == 0)
+      else if (s & PTE_RWLOCK_READERS)
         {
-          result = pthread_cond_signal (&(rwl->cndSharedAccessCompleted));
+          n = s - 1;
+        }
+      else
+        {
+          return EPERM;
         }
-
-      result1 = pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted));
     }
-  else
-    {
-      rwl->nExclusiveAccessCount--;
-
-      result = pthread_mutex_unlock (&(rwl->mtxSharedAccessCompleted));
-      result1 = pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
+  while (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state, n, s) != s);
 
+  if (n == PTE_RWLOCK_WAITERS)
+    {
+      pte_rwlock_wake (rwl);
     }
 
-  return ((result != 0) ? result : result1);
+  return 0;
 }
@@ -51,6 +51,7 @@ pthread_rwlock_wrlock (pthread_rwlock_t * rwlock)
 {
   int result;
   pthread_rwlock_t rwl;
+  pte_thread_t * waiter;
 
   if (rwlock == NULL || *rwlock == NULL)
     {
@@ -80,54 +81,19 @@ pthread_rwlock_wrlock (pthread_rwlock_t * rwlock)
       return EINVAL;
     }
 
-  if ((result = pthread_mutex_lock (&(rwl->mtxExclusiveAccess))) != 0)
+  if (PTE_ATOMIC_COMPARE_EXCHANGE ((int *) &rwl->state,
+                                   PTE_RWLOCK_WRITER, 0) == 0)
     {
-      return result;
+      return 0;
     }
 
-  if ((result = pthread_mutex_lock (&(rwl->mtxSharedAccessCompleted))) != 0)
-    {
-      (void) pthread_mutex_unlock (&(rwl->mtxExclusiveAccess));
-      return result;
-    }
-
-  if (rwl->nExclusiveAccessCount == 0)
-    {
-      if (rwl->nCompletedSharedAccessCount > 0)
-        {
-          rwl->nSharedAccessCount -= rwl->nCompletedSharedAccessCount;
-          rwl->nCompletedSharedAccessCount = 0;
-        }
-
-      if (rwl->nSharedAccessCount > 0)
-        {
-          rwl->nCompletedSharedAccessCount = -rwl->nSharedAccessCount;
-
-          /*
-           * This routine may be a cancelation point
-           * according to POSIX 1003.1j section 18.1.2.
-           */
-          pthread_cleanup_push (pte_rwlock_cancelwrwait, (void *) rwl);
-
-          do
-            {
-              result = pthread_cond_wait (&(rwl->cndSharedAccessCompleted),
-                                          &(rwl->mtxSharedAccessCompleted));
-            }
-          while (result == 0 && rwl->nCompletedSharedAccessCount < 0);
-
-          pthread_cleanup_pop ((result != 0) ? 1 : 0);
-
-          if (result == 0)
-            {
-              rwl->nSharedAccessCount = 0;
-            }
-        }
-    }
+  waiter = pte_waitBegin (PTE_WAIT_RWLOCK, rwl);
+  result = pte_rwlock_wait (rwl, PTE_TRUE, NULL);
+  pte_waitEnd (waiter);
 
   if (result == 0)
     {
-      rwl->nExclusiveAccessCount++;
+      PTE_PROFILE_SAMPLE (waiter);
     }
 
   return result;
@@ -106,7 +106,7 @@ pthread_self (void)
            * No need to explicitly serialise access to sched_priority
            * because the new handle is not yet public.
            */
-          sp->sched_priority = 0;
+          sp->sched_priority = pte_osThreadGetPriority (sp->threadId);
 
           pthread_setspecific (pte_selfThreadKey, (void *) sp);
         }
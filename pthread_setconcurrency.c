@@ -44,16 +44,40 @@
 #include "implement.h"
 
 
+/*
+ * The concurrency level is the number of threads the application
+ * expects to be running at once; 0, the default, leaves it to the
+ * library, which then never polls. Otherwise it sets how long a
+ * contended mutex is polled before its caller blocks. Up to one
+ * runnable thread per CPU, a mutex owner is likely running and about
+ * to release, so polling pays; with more, the owner has likely been
+ * preempted and polling only delays the thread that would run next.
+ * With a single CPU there is never anything to wait for.
+ */
 int
 pthread_setconcurrency (int level)
 {
+  int cpus;
+
   if (level < 0)
     {
       return EINVAL;
     }
+
+  pte_concurrency = level;
+
+  if (level == 0 || pte_getprocessors (&cpus) != 0 || cpus <= 1)
+    {
+      pte_mutexSpinCount = 0;
+    }
+  else if (level <= cpus)
+    {
+      pte_mutexSpinCount = PTE_MUTEX_SPIN_COUNT;
+    }
   else
     {
-      pte_concurrency = level;
-      return 0;
+      pte_mutexSpinCount = PTE_MUTEX_SPIN_COUNT * cpus / level;
     }
+
+  return 0;
 }
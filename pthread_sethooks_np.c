@@ -0,0 +1,96 @@
+/*
+ * pthread_sethooks_np.c
+ *
+ * Description:
+ * Installs the instrumentation hooks called from the library's slow paths.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdlib.h>
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_sethooks_np (const pthread_hooks_np_t * hooks)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Installs a set of instrumentation hooks, replacing
+ *      any previously installed set.
+ *
+ * PARAMETERS
+ *      hooks
+ *              pointer to the hooks to install, any of which
+ *              may be NULL, or NULL to remove all hooks.
+ *
+ * DESCRIPTION
+ *      Hooks are only available when the library is built
+ *      with PTE_HOOKS defined; otherwise every call site
+ *      compiles to nothing.
+ *
+ *      before_block and after_wake bracket each time a POSIX
+ *      thread blocks on a mutex, condition variable,
+ *      semaphore, read-write lock, barrier or join.
+ *      lock_acquired is called when a mutex is obtained after
+ *      blocking and lock_released when a mutex is unlocked
+ *      while it may have waiters (the last waiter to get the
+ *      lock can report a release with none left).
+ *      thread_start and thread_exit are called on the new
+ *      thread as it starts and finishes.
+ *
+ *      Hooks run on the calling thread, in the middle of the
+ *      operation, and must not block or call back into the
+ *      library's synchronisation functions. Each pointer is
+ *      replaced individually, so a thread may still call an
+ *      old hook shortly after it has been replaced.
+ *
+ * RESULTS
+ *              0               successfully installed,
+ *              ENOSYS          hooks not built in.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_HOOKS
+  pthread_hooks_np_t none = { NULL, NULL, NULL, NULL, NULL, NULL };
+
+  if (hooks == NULL)
+    {
+      hooks = &none;
+    }
+
+  pte_hooks.before_block = hooks->before_block;
+  pte_hooks.after_wake = hooks->after_wake;
+  pte_hooks.lock_acquired = hooks->lock_acquired;
+  pte_hooks.lock_released = hooks->lock_released;
+  pte_hooks.thread_start = hooks->thread_start;
+  pte_hooks.thread_exit = hooks->thread_exit;
+
+  return 0;
+#else
+  return ENOSYS;
+#endif
+}
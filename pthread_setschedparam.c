@@ -63,12 +63,6 @@ pthread_setschedparam (pthread_t thread, int policy,
       return EINVAL;
     }
 
-  /* Ensure the policy is SCHED_OTHER. */
-  if (policy != SCHED_OTHER)
-    {
-      return ENOTSUP;
-    }
-
   return (pte_setthreadpriority (thread, policy, param->sched_priority));
 }
 
@@ -106,10 +100,16 @@ pte_setthreadpriority (pthread_t thread, int policy, int priority)
            * not as finally adjusted.
            */
           tp->sched_priority = priority;
+          tp->sched_policy = policy;
         }
 
       (void) pthread_mutex_unlock (&tp->threadLock);
     }
 
+  if (0 == result && policy == SCHED_RR)
+    {
+      pte_rrStart (prio);
+    }
+
   return result;
 }
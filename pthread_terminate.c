@@ -52,6 +52,12 @@ void pthread_terminate(void)
   if (pte_processInitialized)
     {
       pte_thread_t * tp, * tpNext;
+      pte_thread_t ** link;
+
+      /*
+       * Stop the SCHED_RR time slicing thread, if any.
+       */
+      pte_rrStop ();
 
       if (pte_selfThreadKey != NULL)
         {
@@ -75,15 +81,40 @@ void pthread_terminate(void)
 
       pte_osMutexLock (pte_thread_reuse_lock);
 
+      /*
+       * The structs on the reuse stack (those with a prevReuse link)
+       * are about to be freed; take them off pte_threadList first.
+       */
+      link = &pte_threadList;
+      while ((tp = *link) != NULL)
+        {
+          if (tp->prevReuse != NULL)
+            {
+              *link = tp->nextThread;
+            }
+          else
+            {
+              link = &tp->nextThread;
+            }
+        }
 
       tp = pte_threadReuseTop;
       while (tp != PTE_THREAD_REUSE_EMPTY)
         {
           tpNext = tp->prevReuse;
+
+          if (tp->parkSemCreated)
+            {
+              (void) pte_osSemaphoreDelete (tp->parkSem);
+            }
+
           free (tp);
           tp = tpNext;
         }
 
+      pte_threadReuseTop = PTE_THREAD_REUSE_EMPTY;
+      pte_threadReuseBottom = PTE_THREAD_REUSE_EMPTY;
+
       pte_osMutexUnlock(pte_thread_reuse_lock);
 
       pte_processInitialized = PTE_FALSE;
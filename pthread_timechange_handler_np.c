@@ -97,6 +97,8 @@ pthread_timechange_handler_np (void *arg)
   int result = 0;
   pthread_cond_t cv;
 
+  /* Timeouts must not go on using the old wall clock offset. */
+  pte_clockResync ();
 
   pte_osMutexLock (pte_cond_list_lock);
 
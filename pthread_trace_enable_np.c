@@ -0,0 +1,69 @@
+/*
+ * pthread_trace_enable_np.c
+ *
+ * Description:
+ * Switches synchronisation event tracing on or off at run time.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+
+
+int
+pthread_trace_enable_np (int enable)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Starts or stops recording synchronisation events
+ *      (contended mutex locks, condition variable and
+ *      semaphore waits, thread create/start/exit and cancel
+ *      requests) into per-thread ring buffers.
+ *
+ * PARAMETERS
+ *      enable
+ *              non-zero to start recording, zero to stop.
+ *
+ * DESCRIPTION
+ *      Tracing is only available when the library is built
+ *      with PTE_TRACE defined. Stopping does not discard
+ *      events already recorded; they can still be exported
+ *      with pthread_trace_export_np(). Each thread keeps its
+ *      most recent PTE_TRACE_RING_SIZE events.
+ *
+ * RESULTS
+ *              0               successfully changed,
+ *              ENOSYS          tracing not built in.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_TRACE
+  (void) PTE_ATOMIC_EXCHANGE (&pte_traceEnabled, enable ? 1 : 0);
+
+  return 0;
+#else
+  return ENOSYS;
+#endif
+}
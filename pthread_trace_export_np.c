@@ -0,0 +1,182 @@
+/*
+ * pthread_trace_export_np.c
+ *
+ * Description:
+ * Exports recorded synchronisation events as Chrome trace-event JSON.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "pthread.h"
+#include "implement.h"
+
+#ifdef PTE_TRACE
+
+/*
+ * Blocking waits are written as duration ("B"/"E") pairs so that
+ * they show up as spans on the thread's track; everything else is
+ * an instant ("i") event.
+ */
+static const char * const pte_traceNames[PTE_TRACE_EVENT_TYPES] =
+{
+  "mutex_wait",      /* PTE_TRACE_MUTEX_CONTENDED */
+  "mutex_wait",      /* PTE_TRACE_MUTEX_ACQUIRED */
+  "mutex_release",   /* PTE_TRACE_MUTEX_RELEASED */
+  "cond_wait",       /* PTE_TRACE_COND_WAIT */
+  "cond_wait",       /* PTE_TRACE_COND_WAKE */
+  "sem_wait",        /* PTE_TRACE_SEM_BLOCK */
+  "sem_wait",        /* PTE_TRACE_SEM_WAKE */
+  "sem_post",        /* PTE_TRACE_SEM_POST */
+  "thread_create",   /* PTE_TRACE_THREAD_CREATE */
+  "thread",          /* PTE_TRACE_THREAD_START */
+  "thread",          /* PTE_TRACE_THREAD_EXIT */
+  "cancel"           /* PTE_TRACE_CANCEL */
+};
+
+static const char pte_tracePhases[PTE_TRACE_EVENT_TYPES] =
+{
+  'B', 'E', 'i', 'B', 'E', 'B', 'E', 'i', 'i', 'B', 'E', 'i'
+};
+
+static int
+pte_traceExportRing (pte_trace_ring_t * ring,
+                     void (*write) (const char * text, void * arg),
+                     void * arg,
+                     int first)
+{
+  char line[192];
+  int head, start, i;
+
+  head = PTE_ATOMIC_EXCHANGE_ADD (&ring->head, 0);
+  start = head > PTE_TRACE_RING_SIZE ? head - PTE_TRACE_RING_SIZE : 0;
+
+  for (i = start; i < head; i++)
+    {
+      pte_trace_event_t * slot = &ring->events[(unsigned int) i & (PTE_TRACE_RING_SIZE - 1)];
+      pte_trace_event_t ev;
+
+      if (PTE_ATOMIC_EXCHANGE_ADD (&slot->seq, 0) != i + 1)
+        {
+          continue;
+        }
+
+      ev = *slot;
+
+      /*
+       * Skip the entry if a writer lapped us while we copied it; the
+       * writer zeroes seq before changing any field (see
+       * pte_traceEvent()), so a torn copy never passes this check.
+       */
+      if (PTE_ATOMIC_EXCHANGE_ADD (&slot->seq, 0) != i + 1 ||
+          ev.type < 0 || ev.type >= PTE_TRACE_EVENT_TYPES)
+        {
+          continue;
+        }
+
+      snprintf (line, sizeof (line),
+                "%s{\"name\":\"%s\",\"ph\":\"%c\",%s\"ts\":%llu.%03u,"
+                "\"pid\":1,\"tid\":%u,\"args\":{\"object\":\"%p\"}}",
+                first ? "\n" : ",\n",
+                pte_traceNames[ev.type],
+                pte_tracePhases[ev.type],
+                pte_tracePhases[ev.type] == 'i' ? "\"s\":\"t\"," : "",
+                ev.timestamp / 1000,
+                (unsigned int) (ev.timestamp % 1000),
+                ev.thread,
+                ev.object);
+
+      write (line, arg);
+      first = 0;
+    }
+
+  return first;
+}
+
+#endif /* PTE_TRACE */
+
+
+int
+pthread_trace_export_np (void (*write) (const char * text, void * arg),
+                         void * arg)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Writes every event still held in the trace rings as
+ *      a Chrome trace-event JSON document (load it with
+ *      chrome://tracing or Perfetto).
+ *
+ * PARAMETERS
+ *      write
+ *              called with successive NUL-terminated pieces
+ *              of the document, in order.
+ *
+ *      arg
+ *              passed through to 'write'.
+ *
+ * DESCRIPTION
+ *      Export does not stop or block other threads. Events
+ *      that are overwritten while being read are skipped,
+ *      so for a complete picture stop tracing first with
+ *      pthread_trace_enable_np(0). Timestamps are in
+ *      microseconds on the pte_osClockGetNanoseconds()
+ *      time base; thread ids are OS thread handles.
+ *
+ * RESULTS
+ *              0               successfully exported,
+ *              EINVAL          'write' is NULL,
+ *              ENOSYS          tracing not built in.
+ *
+ * ------------------------------------------------------
+ */
+{
+#ifdef PTE_TRACE
+  int first = 1;
+  int i;
+
+  if (write == NULL)
+    {
+      return EINVAL;
+    }
+
+  write ("{\"traceEvents\":[", arg);
+
+  for (i = 0; i < pte_traceRingCount && i < PTE_TRACE_MAX_RINGS; i++)
+    {
+      if (pte_traceRings[i] != NULL)
+        {
+          first = pte_traceExportRing (pte_traceRings[i], write, arg, first);
+        }
+    }
+
+  (void) pte_traceExportRing (&pte_traceSharedRing, write, arg, first);
+
+  write ("\n]}\n", arg);
+
+  return 0;
+#else
+  return ENOSYS;
+#endif
+}
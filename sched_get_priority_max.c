@@ -47,5 +47,11 @@
 int
 sched_get_priority_max (int policy)
 {
+  if (policy < SCHED_MIN || policy > SCHED_MAX)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
   return pte_osThreadGetMaxPriority();
 }
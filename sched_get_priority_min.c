@@ -47,5 +47,23 @@
 int
 sched_get_priority_min (int policy)
 {
+  if (policy < SCHED_MIN || policy > SCHED_MAX)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  /*
+   * SCHED_OTHER keeps the whole OS range, as it always has. The
+   * real-time policies get the band above the default priority, so
+   * that a SCHED_FIFO or SCHED_RR thread always preempts threads
+   * created with default attributes.
+   */
+  if (policy != SCHED_OTHER)
+    {
+      return PTE_MIN (pte_osThreadGetDefaultPriority () + 1,
+                      pte_osThreadGetMaxPriority ());
+    }
+
   return pte_osThreadGetMinPriority();
 }
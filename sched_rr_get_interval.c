@@ -0,0 +1,83 @@
+/*
+ * sched_rr_get_interval.c
+ *
+ * Description:
+ * POSIX thread functions that deal with thread scheduling.
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ */
+
+#include "pthread.h"
+#include "implement.h"
+#include "sched.h"
+
+int
+sched_rr_get_interval (pid_t pid, struct timespec *interval)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Returns the time slice given to SCHED_RR threads.
+ *
+ * PARAMETERS
+ *      pid
+ *              must be 0; there is a single process.
+ *
+ *      interval
+ *              receives the time slice.
+ *
+ * DESCRIPTION
+ *      Fails with ENOTSUP once the first SCHED_RR thread has found
+ *      that the OS cannot rotate its ready queues. Such threads run
+ *      as SCHED_FIFO.
+ *
+ * RESULTS
+ *              0 on success, or -1 with errno set to:
+ *              EINVAL          'interval' is NULL,
+ *              ESRCH           'pid' is not 0,
+ *              ENOTSUP         the OS cannot time slice threads.
+ * ------------------------------------------------------
+ */
+{
+  if (pid != 0)
+    {
+      errno = ESRCH;
+      return -1;
+    }
+
+  if (interval == NULL)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  if (pte_rrState == PTE_RR_UNSUPPORTED)
+    {
+      errno = ENOTSUP;
+      return -1;
+    }
+
+  interval->tv_sec = PTE_RR_QUANTUM_MSECS / 1000;
+  interval->tv_nsec = (PTE_RR_QUANTUM_MSECS % 1000) * 1000000L;
+
+  return 0;
+}
@@ -46,7 +46,69 @@
 
 int
 sched_setscheduler (pid_t pid, int policy)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      Changes the scheduling policy of the calling thread.
+ *
+ * PARAMETERS
+ *      pid
+ *              must be 0; there is a single process.
+ *
+ *      policy
+ *              SCHED_OTHER, SCHED_FIFO or SCHED_RR.
+ *
+ * DESCRIPTION
+ *      There is no sched_param argument, so the thread keeps its
+ *      priority, moved into the range of the new policy if needed.
+ *
+ * RESULTS
+ *              the previous policy, or -1 with errno set to:
+ *              EINVAL          invalid policy,
+ *              ESRCH           'pid' is not 0,
+ *              ENOMEM          implicit self thread create failed.
+ * ------------------------------------------------------
+ */
 {
-  errno = EPERM;
-  return -1;
+  pthread_t self;
+  pte_thread_t * sp;
+  struct sched_param param;
+  int previous;
+  int result;
+
+  if (pid != 0)
+    {
+      errno = ESRCH;
+      return -1;
+    }
+
+  if (policy < SCHED_MIN || policy > SCHED_MAX)
+    {
+      errno = EINVAL;
+      return -1;
+    }
+
+  if ((self = pthread_self ()) == NULL)
+    {
+      errno = ENOMEM;
+      return -1;
+    }
+
+  sp = (pte_thread_t *) self;
+  previous = sp->sched_policy;
+
+  param.sched_priority = PTE_MAX (sp->sched_priority,
+                                  sched_get_priority_min (policy));
+  param.sched_priority = PTE_MIN (param.sched_priority,
+                                  sched_get_priority_max (policy));
+
+  result = pthread_setschedparam (self, policy, &param);
+
+  if (0 != result)
+    {
+      errno = result;
+      return -1;
+    }
+
+  return previous;
 }
@@ -90,10 +90,19 @@ sem_destroy (sem_t * sem)
     {
       result = EINVAL;
     }
+  else if (PTE_IS_COUNT_INITIALIZER (s = *sem)
+           && PTE_ATOMIC_COMPARE_EXCHANGE_PTR (sem, NULL, s) == s)
+    {
+      /* Static semaphore that was never used, nothing to free. */
+      return 0;
+    }
+  else if ((s = *sem) == NULL)
+    {
+      /* Destroyed by another thread while we looked at it. */
+      result = EINVAL;
+    }
   else
     {
-      s = *sem;
-
       if ((result = pthread_mutex_lock (&s->lock)) == 0)
         {
           if (s->value < 0)
@@ -88,6 +88,12 @@ sem_getvalue (sem_t * sem, int *sval)
       errno = EINVAL;
       return -1;
     }
+  else if (PTE_IS_COUNT_INITIALIZER (*sem))
+    {
+      /* Not used yet, so nothing has changed the initial value. */
+      *sval = (int) PTE_COUNT_INITIALIZER_VALUE (*sem);
+      return 0;
+    }
   else
     {
       long value;
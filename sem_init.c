@@ -48,7 +48,7 @@
 
 
 int
-sem_init (sem_t * sem, int pshared, unsigned int value)
+sem_init_np (sem_t * sem, int pshared, unsigned int value, int order)
 /*
  * ------------------------------------------------------
  * DOCPUBLIC
@@ -68,6 +68,12 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
  *      value
  *              initial value of the semaphore counter
  *
+ *      order
+ *              SEM_WAKE_DEFAULT_NP to release waiters in whatever
+ *              order the OS chooses, SEM_WAKE_PRIORITY_NP to
+ *              release them highest sched_priority first
+ *              (sem_init_np only)
+ *
  * DESCRIPTION
  *      This function initializes a semaphore. The
  *      initial value of the semaphore is set to 'value'.
@@ -81,6 +87,8 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
  *              ENOMEM          out of memory,
  *              ENOSPC          a required resource has been exhausted,
  *              ENOSYS          semaphores are not supported,
+ *              ENOTSUP         the OS cannot release waiters in
+ *                              priority order,
  *              EPERM           the process lacks appropriate privilege
  *
  * ------------------------------------------------------
@@ -98,7 +106,8 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
        */
       result = EPERM;
     }
-  else if (value > (unsigned int)SEM_VALUE_MAX)
+  else if (value > (unsigned int)SEM_VALUE_MAX
+           || (order != SEM_WAKE_DEFAULT_NP && order != SEM_WAKE_PRIORITY_NP))
     {
       result = EINVAL;
     }
@@ -116,15 +125,19 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
           s->value = value;
           if (pthread_mutex_init(&s->lock, NULL) == 0)
             {
-
-              pte_osResult osResult = pte_osSemaphoreCreate(0, &s->sem);
-
-
+              /*
+               * s->lock is only held briefly; waiters block on s->sem,
+               * so that is what decides the wake order.
+               */
+              pte_osResult osResult = (order == SEM_WAKE_PRIORITY_NP
+                                       ? pte_osSemaphoreCreateEx(0, PTE_OS_SEMAPHORE_PRIORITY, &s->sem)
+                                       : pte_osSemaphoreCreate(0, &s->sem));
 
               if (osResult != PTE_OS_OK)
                 {
                   (void) pthread_mutex_destroy(&s->lock);
-                  result = ENOSPC;
+                  result = (osResult == PTE_OS_GENERAL_FAILURE
+                            && order == SEM_WAKE_PRIORITY_NP ? ENOTSUP : ENOSPC);
                 }
 
             }
@@ -150,4 +163,10 @@ sem_init (sem_t * sem, int pshared, unsigned int value)
 
   return 0;
 
+}				/* sem_init_np */
+
+int
+sem_init (sem_t * sem, int pshared, unsigned int value)
+{
+  return sem_init_np (sem, pshared, value, SEM_WAKE_DEFAULT_NP);
 }				/* sem_init */
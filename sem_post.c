@@ -83,7 +83,16 @@ sem_post (sem_t * sem)
  */
 {
   int result = 0;
-  sem_t s = *sem;
+  sem_t s;
+
+  if (PTE_IS_COUNT_INITIALIZER (*sem)
+      && (result = pte_sem_check_need_init (sem)) != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  s = *sem;
 
   if (s == NULL)
     {
@@ -102,13 +111,20 @@ sem_post (sem_t * sem)
 
       if (s->value < SEM_VALUE_MAX)
         {
-          pte_osResult osResult = pte_osSemaphorePost(s->sem, 1);
-
-          if (++s->value <= 0
-              && (osResult != PTE_OS_OK))
+          /*
+           * Only release the OS semaphore if there is a waiter for it,
+           * otherwise its count runs ahead of s->value and a later
+           * waiter returns without a matching post.
+           */
+          if (++s->value <= 0)
             {
-              s->value--;
-              result = EINVAL;
+              PTE_TRACE_EVENT (PTE_TRACE_SEM_POST, s);
+
+              if (pte_osSemaphorePost(s->sem, 1) != PTE_OS_OK)
+                {
+                  s->value--;
+                  result = EINVAL;
+                }
             }
 
         }
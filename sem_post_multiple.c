@@ -87,7 +87,16 @@ sem_post_multiple (sem_t * sem, int count)
 {
   int result = 0;
   long waiters;
-  sem_t s = *sem;
+  sem_t s;
+
+  if (PTE_IS_COUNT_INITIALIZER (*sem)
+      && (result = pte_sem_check_need_init (sem)) != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  s = *sem;
 
   if (s == NULL || count <= 0)
     {
@@ -110,6 +119,7 @@ sem_post_multiple (sem_t * sem, int count)
           s->value += count;
           if (waiters > 0)
             {
+              PTE_TRACE_EVENT (PTE_TRACE_SEM_POST, s);
 
               pte_osSemaphorePost(s->sem, (waiters<=count)?waiters:count);
               result = 0;
@@ -98,48 +98,36 @@ pte_sem_timedwait_cleanup (void * args)
 }
 
 
-int
-sem_timedwait (sem_t * sem, const struct timespec *abstime)
+static int
+pte_sem_timedwait (sem_t * sem, const struct timespec * abstime,
+                   const unsigned int * pRelTimeout)
 /*
  * ------------------------------------------------------
- * DOCPUBLIC
- *      This function waits on a semaphore possibly until
- *      'abstime' time.
- *
- * PARAMETERS
- *      sem
- *              pointer to an instance of sem_t
- *
- *      abstime
- *              pointer to an instance of struct timespec
- *
  * DESCRIPTION
- *      This function waits on a semaphore. If the
- *      semaphore value is greater than zero, it decreases
- *      its value by one. If the semaphore value is zero, then
- *      the calling thread (or process) is blocked until it can
- *      successfully decrease the value or until interrupted by
- *      a signal.
+ *      Waits on 'sem' until 'abstime', for at most *pRelTimeout
+ *      milliseconds, or forever if both are NULL. Common to
+ *      sem_timedwait() and sem_reltimedwait_np().
  *
- *      If 'abstime' is a NULL pointer then this function will
- *      block until it can successfully decrease the value or
- *      until interrupted by a signal.
+ *      The timeout is only worked out if the semaphore has to
+ *      be waited for, so taking an available one does not read
+ *      the clock.
  *
  * RESULTS
- *              0               successfully decreased semaphore,
- *              -1              failed, error in errno
- * ERRNO
- *              EINVAL          'sem' is not a valid semaphore,
- *              ENOSYS          semaphores are not supported,
- *              EINTR           the function was interrupted by a signal,
- *              EDEADLK         a deadlock condition was detected.
- *              ETIMEDOUT       abstime elapsed before success.
- *
+ *      As sem_timedwait().
  * ------------------------------------------------------
  */
 {
   int result = 0;
-  sem_t s = *sem;
+  sem_t s;
+
+  if (PTE_IS_COUNT_INITIALIZER (*sem)
+      && (result = pte_sem_check_need_init (sem)) != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  s = *sem;
 
 
   pthread_testcancel();
@@ -150,25 +138,10 @@ sem_timedwait (sem_t * sem, const struct timespec *abstime)
     }
   else
     {
-      unsigned int milliseconds;
-      unsigned int *pTimeout;
-
-      if (abstime == NULL)
-        {
-          pTimeout = NULL;
-        }
-      else
-        {
-          /*
-           * Calculate timeout as milliseconds from current system time.
-           */
-          milliseconds = pte_relmillisecs (abstime);
-          pTimeout = &milliseconds;
-        }
-
       if ((result = pthread_mutex_lock (&s->lock)) == 0)
         {
           int v;
+          pte_thread_t * waiter;
 
           /* See sem_destroy.c
            */
@@ -187,16 +160,38 @@ sem_timedwait (sem_t * sem, const struct timespec *abstime)
 
               {
                 sem_timedwait_cleanup_args_t cleanup_args;
+                unsigned int milliseconds;
+                unsigned int *pTimeout = &milliseconds;
+
+                if (pRelTimeout != NULL)
+                  {
+                    milliseconds = *pRelTimeout;
+                  }
+                else if (abstime != NULL)
+                  {
+                    /*
+                     * Calculate timeout as milliseconds from current system time.
+                     */
+                    milliseconds = pte_relmillisecs (abstime);
+                  }
+                else
+                  {
+                    pTimeout = NULL;
+                  }
 
                 cleanup_args.sem = s;
                 cleanup_args.resultPtr = &result;
 
                 /* Must wait */
+                PTE_TRACE_EVENT (PTE_TRACE_SEM_BLOCK, s);
+                waiter = pte_waitBegin (PTE_WAIT_SEM, s);
                 pthread_cleanup_push(pte_sem_timedwait_cleanup, (void *) &cleanup_args);
 
                 result = pte_cancellable_wait(s->sem,pTimeout);
 
                 pthread_cleanup_pop(result);
+                pte_waitEnd (waiter);
+                PTE_TRACE_EVENT (PTE_TRACE_SEM_WAKE, s);
               }
             }
         }
@@ -213,4 +208,94 @@ sem_timedwait (sem_t * sem, const struct timespec *abstime)
 
   return 0;
 
+}				/* pte_sem_timedwait */
+
+
+int
+sem_timedwait (sem_t * sem, const struct timespec *abstime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits on a semaphore possibly until
+ *      'abstime' time.
+ *
+ * PARAMETERS
+ *      sem
+ *              pointer to an instance of sem_t
+ *
+ *      abstime
+ *              pointer to an instance of struct timespec
+ *
+ * DESCRIPTION
+ *      This function waits on a semaphore. If the
+ *      semaphore value is greater than zero, it decreases
+ *      its value by one. If the semaphore value is zero, then
+ *      the calling thread (or process) is blocked until it can
+ *      successfully decrease the value or until interrupted by
+ *      a signal.
+ *
+ *      If 'abstime' is a NULL pointer then this function will
+ *      block until it can successfully decrease the value or
+ *      until interrupted by a signal.
+ *
+ * RESULTS
+ *              0               successfully decreased semaphore,
+ *              -1              failed, error in errno
+ * ERRNO
+ *              EINVAL          'sem' is not a valid semaphore,
+ *              ENOSYS          semaphores are not supported,
+ *              EINTR           the function was interrupted by a signal,
+ *              EDEADLK         a deadlock condition was detected.
+ *              ETIMEDOUT       abstime elapsed before success.
+ *
+ * ------------------------------------------------------
+ */
+{
+  return pte_sem_timedwait (sem, abstime, NULL);
+
 }				/* sem_timedwait */
+
+
+int
+sem_reltimedwait_np (sem_t * sem, const struct timespec *reltime)
+/*
+ * ------------------------------------------------------
+ * DOCPUBLIC
+ *      This function waits on a semaphore for at most
+ *      'reltime'.
+ *
+ * PARAMETERS
+ *      sem
+ *              pointer to an instance of sem_t
+ *
+ *      reltime
+ *              pointer to an instance of struct timespec
+ *
+ * DESCRIPTION
+ *      As sem_timedwait(), but the timeout is an interval from
+ *      now. It is passed to the OS as it is, without reading
+ *      the clock.
+ *
+ * RESULTS
+ *              0               successfully decreased semaphore,
+ *              -1              failed, error in errno
+ * ERRNO
+ *              EINVAL          'sem' or 'reltime' is invalid,
+ *              ETIMEDOUT       reltime elapsed before success.
+ *
+ * ------------------------------------------------------
+ */
+{
+  unsigned int milliseconds;
+  int result;
+
+  if ((result = pte_reltimeout (reltime, &milliseconds)) != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  return pte_sem_timedwait (sem, NULL, &milliseconds);
+
+}				/* sem_reltimedwait_np */
+
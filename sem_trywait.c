@@ -83,7 +83,16 @@ sem_trywait (sem_t * sem)
  */
 {
   int result = 0;
-  sem_t s = *sem;
+  sem_t s;
+
+  if (PTE_IS_COUNT_INITIALIZER (*sem)
+      && (result = pte_sem_check_need_init (sem)) != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  s = *sem;
 
   if (s == NULL)
     {
@@ -118,7 +118,16 @@ sem_wait (sem_t * sem)
  */
 {
   int result = 0;
-  sem_t s = *sem;
+  sem_t s;
+
+  if (PTE_IS_COUNT_INITIALIZER (*sem)
+      && (result = pte_sem_check_need_init (sem)) != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  s = *sem;
 
   pthread_testcancel();
 
@@ -131,6 +140,7 @@ sem_wait (sem_t * sem)
       if ((result = pthread_mutex_lock (&s->lock)) == 0)
         {
           int v;
+          pte_thread_t * waiter;
 
           /* See sem_destroy.c
            */
@@ -147,10 +157,14 @@ sem_wait (sem_t * sem)
           if (v < 0)
             {
               /* Must wait */
+              PTE_TRACE_EVENT (PTE_TRACE_SEM_BLOCK, s);
+              waiter = pte_waitBegin (PTE_WAIT_SEM, s);
               pthread_cleanup_push(pte_sem_wait_cleanup, (void *) s);
               result = pte_cancellable_wait(s->sem,NULL);
               /* Cleanup if we're canceled or on any other error */
               pthread_cleanup_pop(result);
+              pte_waitEnd (waiter);
+              PTE_TRACE_EVENT (PTE_TRACE_SEM_WAKE, s);
 
               // Wait was cancelled, indicate that we're no longer waiting on this semaphore.
               /*
@@ -209,7 +223,16 @@ sem_wait_nocancel (sem_t * sem)
  */
 {
   int result = 0;
-  sem_t s = *sem;
+  sem_t s;
+
+  if (PTE_IS_COUNT_INITIALIZER (*sem)
+      && (result = pte_sem_check_need_init (sem)) != 0)
+    {
+      errno = result;
+      return -1;
+    }
+
+  s = *sem;
 
   pthread_testcancel();
 
@@ -222,6 +245,7 @@ sem_wait_nocancel (sem_t * sem)
       if ((result = pthread_mutex_lock (&s->lock)) == 0)
         {
           int v;
+          pte_thread_t * waiter;
 
           /* See sem_destroy.c
            */
@@ -237,7 +261,9 @@ sem_wait_nocancel (sem_t * sem)
 
           if (v < 0)
             {
+              waiter = pte_waitBegin (PTE_WAIT_SEM, s);
               pte_osSemaphorePend(s->sem, NULL);
+              pte_waitEnd (waiter);
             }
         }
 
@@ -77,10 +77,29 @@ extern "C"
 
     typedef struct sem_t_ * sem_t;
 
+    /*
+     * Semaphore with initial value 'value', created on first use.
+     * sem_destroy() is only needed once it has been used.
+     */
+#define SEM_INITIALIZER_NP(value) \
+  ((sem_t) (((unsigned long) (value) << 1) | 1))
+
     int sem_init (sem_t * sem,
                   int pshared,
                   unsigned int value);
 
+    /*
+     * sem_init() with a wake order: SEM_WAKE_PRIORITY_NP releases
+     * waiters highest sched_priority first.
+     */
+#define SEM_WAKE_DEFAULT_NP  0
+#define SEM_WAKE_PRIORITY_NP 1
+
+    int sem_init_np (sem_t * sem,
+                     int pshared,
+                     unsigned int value,
+                     int order);
+
     int sem_destroy (sem_t * sem);
 
     int sem_trywait (sem_t * sem);
@@ -90,6 +109,12 @@ extern "C"
     int sem_timedwait (sem_t * sem,
                        const struct timespec * abstime);
 
+    /*
+     * sem_timedwait() with a timeout relative to now.
+     */
+    int sem_reltimedwait_np (sem_t * sem,
+                             const struct timespec * reltime);
+
     int sem_post (sem_t * sem);
 
     int sem_post_multiple (sem_t * sem,
@@ -106,7 +106,7 @@ struct pthread_once_t_ {
     int          state;
     void *       semaphore;
     int          numSemaphoreUsers;
-    int          done;        /* indicates if user function has been executed */
+    int          result;      /* init routine's result, see pthread_once_result_np() */
 };
 typedef struct pthread_once_t_ pthread_once_t;
 #define _PTHREAD_ONCE_INIT       { 0, 0, 0, 0}
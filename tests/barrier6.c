@@ -0,0 +1,94 @@
+/*
+ * barrier6.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Declare a barrier with PTHREAD_BARRIER_INITIALIZER_NP() and
+ * have all threads reach it for the first time together.
+ *
+ */
+
+#include "test.h"
+
+enum
+{
+  NUMTHREADS = 8,
+  ROUNDS = 100
+};
+
+static pthread_barrier_t barrier = PTHREAD_BARRIER_INITIALIZER_NP(NUMTHREADS);
+static pthread_barrier_t unused = PTHREAD_BARRIER_INITIALIZER_NP(2);
+static int serialCount = 0;
+
+static void *
+func(void * arg)
+{
+  int i;
+  int result;
+
+  for (i = 0; i < ROUNDS; i++)
+    {
+      result = pthread_barrier_wait(&barrier);
+
+      assert(result == 0 || result == PTHREAD_BARRIER_SERIAL_THREAD);
+
+      if (result == PTHREAD_BARRIER_SERIAL_THREAD)
+        {
+          pte_osAtomicIncrement(&serialCount);
+        }
+    }
+
+  return NULL;
+}
+
+int pthread_test_barrier6(void)
+{
+  int i;
+  pthread_t t[NUMTHREADS];
+
+  barrier = PTHREAD_BARRIER_INITIALIZER_NP(NUMTHREADS);
+  unused = PTHREAD_BARRIER_INITIALIZER_NP(2);
+
+  serialCount = 0;
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, func, NULL) == 0);
+    }
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(serialCount == ROUNDS);
+
+  assert(pthread_barrier_destroy(&barrier) == 0);
+  assert(pthread_barrier_destroy(&unused) == 0);
+  assert(pthread_barrier_wait(&unused) == EINVAL);
+
+  return 0;
+}
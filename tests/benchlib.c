@@ -40,6 +40,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "pthread.h"
 #include "sched.h"
 #include "semaphore.h"
@@ -73,3 +74,359 @@ interlocked_dec_with_conditionals(int * a)
 
 
 /****************************************************************************************/
+
+/*
+ * Benchmark harness
+ */
+
+static void
+nullOp(void * arg, long iterations)
+{
+  volatile long j = 0;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      j++;
+    }
+}
+
+static int
+compareDouble(const void * a, const void * b)
+{
+  double da = *(const double *) a;
+  double db = *(const double *) b;
+
+  return (da > db) - (da < db);
+}
+
+/*
+ * Newton's method, to avoid pulling in libm for one square root.
+ */
+static double
+squareRoot(double x)
+{
+  double r = x;
+  int i;
+
+  if (x <= 0.0)
+    {
+      return 0.0;
+    }
+
+  for (i = 0; i < 64; i++)
+    {
+      r = 0.5 * (r + x / r);
+    }
+
+  return r;
+}
+
+static unsigned long long
+timeRun(benchOp op, void * arg, long iterations)
+{
+  unsigned long long start = pte_osClockGetNanoseconds();
+
+  op(arg, iterations);
+
+  return pte_osClockGetNanoseconds() - start;
+}
+
+/*
+ * Double the repetition count until a single run is long enough
+ * to be measured accurately.
+ */
+static long
+calibrate(benchOp op, void * arg)
+{
+  long iterations = 1;
+
+  while (iterations < BENCH_MAX_ITERATIONS &&
+         timeRun(op, arg, iterations) < BENCH_MIN_RUN_NSECS)
+    {
+      iterations *= 2;
+    }
+
+  return iterations;
+}
+
+static void
+sample(benchOp op, void * arg, long iterations, double * samples)
+{
+  int i;
+
+  for (i = 0; i < BENCH_WARMUP_RUNS; i++)
+    {
+      (void) timeRun(op, arg, iterations);
+    }
+
+  for (i = 0; i < BENCH_RUNS; i++)
+    {
+      samples[i] = (double) timeRun(op, arg, iterations) / iterations;
+    }
+
+  qsort(samples, BENCH_RUNS, sizeof(double), compareDouble);
+}
+
+void
+benchSummarise(double * samples, int count, benchResult * result)
+{
+  double sum = 0.0, sumSq = 0.0, mean;
+  int i;
+
+  qsort(samples, count, sizeof(double), compareDouble);
+
+  for (i = 0; i < count; i++)
+    {
+      sum += samples[i];
+    }
+
+  mean = sum / count;
+
+  for (i = 0; i < count; i++)
+    {
+      sumSq += (samples[i] - mean) * (samples[i] - mean);
+    }
+
+  result->iterations = 1;
+  result->threads = 1;
+  result->runs = count;
+  result->minNs = samples[0];
+  result->medianNs = samples[count / 2];
+  result->p99Ns = samples[(count * 99 + 99) / 100 - 1];
+  result->meanNs = mean;
+  result->stddevNs = count > 1 ? squareRoot(sumSq / (count - 1)) : 0.0;
+}
+
+void
+benchRun(benchOp op, void * arg, benchResult * result)
+{
+  double samples[BENCH_RUNS];
+  double overhead[BENCH_RUNS];
+  long iterations;
+  int i;
+
+  iterations = calibrate(op, arg);
+
+  sample(nullOp, NULL, iterations, overhead);
+  sample(op, arg, iterations, samples);
+
+  for (i = 0; i < BENCH_RUNS; i++)
+    {
+      samples[i] -= overhead[BENCH_RUNS / 2];
+
+      if (samples[i] < 0.0)
+        {
+          samples[i] = 0.0;
+        }
+    }
+
+  benchSummarise(samples, BENCH_RUNS, result);
+  result->iterations = iterations;
+}
+
+void
+benchPrintHeader(void)
+{
+  printf( "%-40s %10s %10s %10s %10s\n",
+          "Test",
+          "min(ns)",
+          "median(ns)",
+          "p99(ns)",
+          "stddev");
+}
+
+void
+benchPrintResult(const char * testNameString, const benchResult * result)
+{
+  benchRecord(testNameString, result);
+
+  printf( "%-40s %10.1f %10.1f %10.1f %10.1f\n",
+          testNameString,
+          result->minNs,
+          result->medianNs,
+          result->p99Ns,
+          result->stddevNs);
+}
+
+/****************************************************************************************/
+
+/*
+ * Machine-readable reporting
+ */
+
+typedef struct benchRecord_
+  {
+    char suite[BENCH_MAX_NAME];
+    char name[BENCH_MAX_NAME];
+    benchResult result;
+  } benchRecord_t;
+
+static benchRecord_t records[BENCH_MAX_RECORDS];
+static int numRecords;
+static char currentSuite[BENCH_MAX_NAME] = "";
+static FILE * reportFp = NULL;
+static int reportFormat;
+
+/*
+ * Names end up in CSV fields, so commas are replaced.
+ */
+static void
+copyName(char * dst, const char * src)
+{
+  int i;
+
+  for (i = 0; i < BENCH_MAX_NAME - 1 && src[i] != '\0'; i++)
+    {
+      dst[i] = (src[i] == ',' || src[i] == '"') ? ';' : src[i];
+    }
+
+  dst[i] = '\0';
+}
+
+void
+benchSetSuite(const char * suite)
+{
+  copyName(currentSuite, suite);
+}
+
+void
+benchReportOpen(FILE * fp, int format)
+{
+  reportFp = fp;
+  reportFormat = format;
+  numRecords = 0;
+
+  if (reportFormat == BENCH_FORMAT_JSON)
+    {
+      fprintf(reportFp, "[\n");
+    }
+  else
+    {
+      fprintf(reportFp, "suite,test,threads,iterations,min_ns,median_ns,p99_ns,mean_ns,stddev_ns\n");
+    }
+}
+
+void
+benchReportClose(void)
+{
+  if (reportFp != NULL && reportFormat == BENCH_FORMAT_JSON)
+    {
+      fprintf(reportFp, "\n]\n");
+    }
+
+  reportFp = NULL;
+}
+
+void
+benchRecord(const char * testNameString, const benchResult * result)
+{
+  benchRecord_t * r;
+
+  if (reportFp == NULL || numRecords == BENCH_MAX_RECORDS)
+    {
+      return;
+    }
+
+  r = &records[numRecords++];
+  copyName(r->suite, currentSuite);
+  copyName(r->name, testNameString);
+  r->result = *result;
+
+  if (reportFormat == BENCH_FORMAT_JSON)
+    {
+      fprintf(reportFp,
+              "%s  {\"suite\": \"%s\", \"test\": \"%s\", \"threads\": %d, \"iterations\": %ld, "
+              "\"min_ns\": %.1f, \"median_ns\": %.1f, \"p99_ns\": %.1f, "
+              "\"mean_ns\": %.1f, \"stddev_ns\": %.1f}",
+              numRecords > 1 ? ",\n" : "",
+              r->suite, r->name, result->threads, result->iterations,
+              result->minNs, result->medianNs, result->p99Ns,
+              result->meanNs, result->stddevNs);
+    }
+  else
+    {
+      fprintf(reportFp, "%s,%s,%d,%ld,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+              r->suite, r->name, result->threads, result->iterations,
+              result->minNs, result->medianNs, result->p99Ns,
+              result->meanNs, result->stddevNs);
+    }
+}
+
+/*
+ * Split a CSV line in place. Returns the number of fields found.
+ */
+static int
+splitFields(char * line, char ** fields, int maxFields)
+{
+  int n = 0;
+
+  fields[n++] = line;
+
+  for (; *line != '\0' && *line != '\n' && *line != '\r'; line++)
+    {
+      if (*line == ',' && n < maxFields)
+        {
+          *line = '\0';
+          fields[n++] = line + 1;
+        }
+    }
+
+  *line = '\0';
+
+  return n;
+}
+
+int
+benchCompareBaseline(const char * path, double thresholdPercent)
+{
+  FILE * fp;
+  char line[256];
+  char * f[9];
+  int i, regressions = 0;
+
+  if ((fp = fopen(path, "r")) == NULL)
+    {
+      return -1;
+    }
+
+  while (fgets(line, sizeof(line), fp) != NULL)
+    {
+      double baseNs;
+      int threads;
+
+      if (splitFields(line, f, 9) != 9 || strcmp(f[0], "suite") == 0)
+        {
+          continue;
+        }
+
+      threads = atoi(f[2]);
+      baseNs = atof(f[5]);
+
+      for (i = 0; i < numRecords; i++)
+        {
+          benchRecord_t * r = &records[i];
+
+          if (strcmp(r->suite, f[0]) != 0 ||
+              strcmp(r->name, f[1]) != 0 ||
+              r->result.threads != threads)
+            {
+              continue;
+            }
+
+          if (r->result.medianNs > baseNs * (1.0 + thresholdPercent / 100.0))
+            {
+              printf("REGRESSION %s/%s (%d threads): %.1f ns -> %.1f ns (%+.1f%%)\n",
+                     r->suite, r->name, threads, baseNs, r->result.medianNs,
+                     baseNs > 0.0 ? (r->result.medianNs - baseNs) * 100.0 / baseNs : 100.0);
+              regressions++;
+            }
+
+          break;
+        }
+    }
+
+  fclose(fp);
+
+  return regressions;
+}
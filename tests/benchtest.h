@@ -49,4 +49,69 @@ void dummy_call(int * a);
 void interlocked_inc_with_conditionals(int *a);
 void interlocked_dec_with_conditionals(int *a);
 
+/*
+ * Benchmark harness (see benchlib.c).
+ *
+ * Time is taken from the OSAL nanosecond clock. Each timed run executes
+ * the operation enough times to span at least BENCH_MIN_RUN_NSECS, so
+ * clock granularity does not dominate the result. After BENCH_WARMUP_RUNS
+ * untimed runs, BENCH_RUNS timed runs are collected and summarised.
+ * Loop overhead, measured the same way, is subtracted from every sample.
+ */
+#define BENCH_WARMUP_RUNS       3
+#define BENCH_RUNS              31
+#define BENCH_MIN_RUN_NSECS     2000000ULL
+#define BENCH_MAX_ITERATIONS    (1L << 24)
+
+/*
+ * An operation under test: perform 'iterations' repetitions of it.
+ */
+typedef void (*benchOp)(void * arg, long iterations);
+
+typedef struct benchResult_
+  {
+    long iterations;            /* Repetitions per timed run */
+    int threads;                /* Threads taking part */
+    int runs;                   /* Number of timed runs */
+    double minNs;               /* Per-operation statistics, nanoseconds */
+    double medianNs;
+    double p99Ns;
+    double meanNs;
+    double stddevNs;
+  } benchResult;
+
+void benchRun(benchOp op, void * arg, benchResult * result);
+/*
+ * Summarise 'count' raw per-operation samples (sorted in place).
+ */
+void benchSummarise(double * samples, int count, benchResult * result);
+void benchPrintHeader(void);
+void benchPrintResult(const char * testNameString, const benchResult * result);
+
+/*
+ * Machine-readable reporting.
+ *
+ * While a report is open every result printed with benchPrintResult(),
+ * or passed to benchRecord() directly, is also written to it as one
+ * CSV line or JSON object, tagged with the current suite name.
+ * Results are kept so that they can be compared against a CSV
+ * baseline written by an earlier run.
+ */
+#define BENCH_FORMAT_CSV        0
+#define BENCH_FORMAT_JSON       1
+
+#define BENCH_MAX_RECORDS       128
+#define BENCH_MAX_NAME          64
+
+void benchSetSuite(const char * suite);
+void benchReportOpen(FILE * fp, int format);
+void benchReportClose(void);
+void benchRecord(const char * testNameString, const benchResult * result);
+/*
+ * Returns the number of results whose median is more than
+ * 'thresholdPercent' slower than the baseline, or -1 if the
+ * baseline cannot be read.
+ */
+int benchCompareBaseline(const char * path, double thresholdPercent);
+
 /****************************************************************************************/
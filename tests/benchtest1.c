@@ -55,146 +55,136 @@
 #include "benchtest.h"
 
 #define PTW32_MUTEX_TYPES
-#define ITERATIONS      100000L
 
 static pthread_mutex_t mx;
 static pthread_mutexattr_t ma;
-static struct _timeb currSysTimeStart;
-static struct _timeb currSysTimeStop;
-static long durationMilliSecs;
-static long overHeadMilliSecs = 0;
+static pte_osMutexHandle cs;
 static int one = 1;
 static int zero = 0;
 
-#define GetDurationMilliSecs(_TStart, _TStop) ((_TStop.time*1000+_TStop.millitm) \
-                                               - (_TStart.time*1000+_TStart.millitm))
 
-/*
- * Dummy use of j, otherwise the loop may be removed by the optimiser
- * when doing the overhead timing with an empty loop.
- */
-#define TESTSTART \
-  { int i, j = 0, k = 0; _ftime(&currSysTimeStart); for (i = 0; i < ITERATIONS; i++) { j++;
+static void
+dummyCallOp (void * arg, long iterations)
+{
+  int * pi = (int *) arg;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      assert((dummy_call(pi), 1) == one);
+      assert((dummy_call(pi), 1) == one);
+    }
+}
+
+static void
+interlockedCondOp (void * arg, long iterations)
+{
+  int * pi = (int *) arg;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      assert((interlocked_inc_with_conditionals(pi), 1) == one);
+      assert((interlocked_dec_with_conditionals(pi), 1) == one);
+    }
+}
 
-#define TESTSTOP \
-  }; _ftime(&currSysTimeStop); if (j + k == i) j++; }
+static void
+interlockedOp (void * arg, long iterations)
+{
+  int * pi = (int *) arg;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      assert((PTE_ATOMIC_INCREMENT(pi), 1) == one);
+      assert((PTE_ATOMIC_INCREMENT(pi), 1) == one);
+    }
+}
+
+static void
+criticalSectionOp (void * arg, long iterations)
+{
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      pte_osMutexLock(cs);
+      pte_osMutexUnlock(cs);
+    }
+}
+
+static void
+lockUnlockOp (void * arg, long iterations)
+{
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      assert(pthread_mutex_lock(&mx) == zero);
+      assert(pthread_mutex_unlock(&mx) == zero);
+    }
+}
+
+static void
+lockUnlockNormalOp (void * arg, long iterations)
+{
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      assert(pthread_mutex_lock_normal_np(&mx) == zero);
+      assert(pthread_mutex_unlock_normal_np(&mx) == zero);
+    }
+}
 
 
 static void
 runTest (char * testNameString, int mType)
 {
+  benchResult result;
+
 #ifdef PTW32_MUTEX_TYPES
   assert(pthread_mutexattr_settype(&ma, mType) == 0);
 #endif
   assert(pthread_mutex_init(&mx, &ma) == 0);
 
-  TESTSTART
-  assert(pthread_mutex_lock(&mx) == zero);
-  assert(pthread_mutex_unlock(&mx) == zero);
-  TESTSTOP
+  benchRun(lockUnlockOp, NULL, &result);
 
   assert(pthread_mutex_destroy(&mx) == 0);
 
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-
-  printf( "%-45s %15ld %15.3f\n",
-          testNameString,
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS);
+  benchPrintResult(testNameString, &result);
 }
 
 
 int pthread_test_bench1()
 {
   int i = 0;
-  pte_osMutexHandle cs;
+  benchResult result;
 
-  overHeadMilliSecs = 0;
   one = 1;
   zero = 0;
 
   pthread_mutexattr_init(&ma);
 
   printf( "=============================================================================\n");
-  printf( "\nLock plus unlock on an unlocked mutex.\n%ld iterations\n\n",
-          ITERATIONS);
-  printf( "%-45s %15s %15s\n",
-          "Test",
-          "Total(msec)",
-          "average(usec)");
-
-  /*
-   * Time the loop overhead so we can subtract it from the actual test times.
-   */
-
-  TESTSTART
-  assert(1 == one);
-  assert(1 == one);
-  TESTSTOP
-
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-  overHeadMilliSecs = durationMilliSecs;
-
-
-  TESTSTART
-  assert((dummy_call(&i), 1) == one);
-  assert((dummy_call(&i), 1) == one);
-  TESTSTOP
-
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-
-  printf( "%-45s %15ld %15.3f\n",
-          "Dummy call x 2",
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS);
-
-
-  TESTSTART
-  assert((interlocked_inc_with_conditionals(&i), 1) == one);
-  assert((interlocked_dec_with_conditionals(&i), 1) == one);
-  TESTSTOP
-
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
+  printf( "\nLock plus unlock on an unlocked mutex.\n");
+  printf( "Per-operation time over %d runs.\n\n", BENCH_RUNS);
+  benchPrintHeader();
 
-  printf( "%-45s %15ld %15.3f\n",
-          "Dummy call -> Interlocked with cond x 2",
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS);
+  benchRun(dummyCallOp, &i, &result);
+  benchPrintResult("Dummy call x 2", &result);
 
-  TESTSTART
-  assert((PTE_ATOMIC_INCREMENT(&i), 1) == one);
-  assert((PTE_ATOMIC_INCREMENT(&i), 1) == one);
-  TESTSTOP
-
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-
-  printf( "%-45s %15ld %15.3f\n",
-          "InterlockedOp x 2",
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS);
+  benchRun(interlockedCondOp, &i, &result);
+  benchPrintResult("Dummy call -> Interlocked with cond x 2", &result);
 
+  benchRun(interlockedOp, &i, &result);
+  benchPrintResult("InterlockedOp x 2", &result);
 
   pte_osMutexCreate(&cs);
-
-  TESTSTART
-  {
-
-    pte_osMutexLock(cs);
-    pte_osMutexUnlock(cs);
-  }
-  TESTSTOP
-
+  benchRun(criticalSectionOp, NULL, &result);
   pte_osMutexDelete(cs);
-
-
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-
-  printf( "%-45s %15ld %15.3f\n",
-          "Simple Critical Section",
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS);
-
-
+  benchPrintResult("Simple Critical Section", &result);
 
   printf( ".............................................................................\n");
 
@@ -209,6 +199,12 @@ int pthread_test_bench1()
   runTest("PTHREAD_MUTEX_ERRORCHECK", PTHREAD_MUTEX_ERRORCHECK);
 
   runTest("PTHREAD_MUTEX_RECURSIVE", PTHREAD_MUTEX_RECURSIVE);
+
+  assert(pthread_mutexattr_settype(&ma, PTHREAD_MUTEX_NORMAL) == 0);
+  assert(pthread_mutex_init(&mx, &ma) == 0);
+  benchRun(lockUnlockNormalOp, NULL, &result);
+  assert(pthread_mutex_destroy(&mx) == 0);
+  benchPrintResult("pthread_mutex_lock_normal_np", &result);
 #else
   runTest("Non-blocking lock", 0);
 #endif
@@ -221,6 +217,5 @@ int pthread_test_bench1()
 
   pthread_mutexattr_destroy(&ma);
 
-  one = i; /* Dummy assignment to avoid 'variable unused' warning */
   return 0;
 }
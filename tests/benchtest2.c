@@ -58,63 +58,52 @@
 #include "benchtest.h"
 
 #define PTW32_MUTEX_TYPES
-#define ITERATIONS      10000L
 
 static pthread_mutex_t gate1, gate2;
 static pthread_mutexattr_t ma;
-static long durationMilliSecs;
-static long overHeadMilliSecs = 0;
-static struct _timeb currSysTimeStart;
-static struct _timeb currSysTimeStop;
 static pthread_t worker;
 static int running = 0;
 
-#define GetDurationMilliSecs(_TStart, _TStop) ((_TStop.time*1000+_TStop.millitm) \
-                                               - (_TStart.time*1000+_TStart.millitm))
-
-/*
- * Dummy use of j, otherwise the loop may be removed by the optimiser
- * when doing the overhead timing with an empty loop.
- */
-#define TESTSTART \
-  { int i, j = 0, k = 0; _ftime(&currSysTimeStart); for (i = 0; i < ITERATIONS; i++) { j++;
-
-#define TESTSTOP \
-  }; _ftime(&currSysTimeStop); if (j + k == i) j++; }
-
 
 static void *
-overheadThread(void * arg)
+workerThread(void * arg)
 {
   do
     {
+      (void) pthread_mutex_lock(&gate1);
+      (void) pthread_mutex_lock(&gate2);
+      (void) pthread_mutex_unlock(&gate1);
       sched_yield();
+      (void) pthread_mutex_unlock(&gate2);
     }
   while (running);
 
   return NULL;
 }
 
-
-static void *
-workerThread(void * arg)
+/*
+ * One iteration is four locks/unlocks.
+ */
+static void
+lockStepOp (void * arg, long iterations)
 {
-  do
+  long i;
+
+  for (i = 0; i < iterations; i++)
     {
-      (void) pthread_mutex_lock(&gate1);
-      (void) pthread_mutex_lock(&gate2);
       (void) pthread_mutex_unlock(&gate1);
       sched_yield();
       (void) pthread_mutex_unlock(&gate2);
+      (void) pthread_mutex_lock(&gate1);
+      (void) pthread_mutex_lock(&gate2);
     }
-  while (running);
-
-  return NULL;
 }
 
 static void
 runTest (char * testNameString, int mType)
 {
+  benchResult result;
+
 #ifdef PTW32_MUTEX_TYPES
   assert(pthread_mutexattr_settype(&ma, mType) == 0);
 #endif
@@ -124,24 +113,15 @@ runTest (char * testNameString, int mType)
   assert(pthread_mutex_lock(&gate2) == 0);
   running = 1;
   assert(pthread_create(&worker, NULL, workerThread, NULL) == 0);
-  TESTSTART
-  (void) pthread_mutex_unlock(&gate1);
-  sched_yield();
-  (void) pthread_mutex_unlock(&gate2);
-  (void) pthread_mutex_lock(&gate1);
-  (void) pthread_mutex_lock(&gate2);
-  TESTSTOP
+  benchRun(lockStepOp, NULL, &result);
   running = 0;
   assert(pthread_mutex_unlock(&gate2) == 0);
   assert(pthread_mutex_unlock(&gate1) == 0);
   assert(pthread_join(worker, NULL) == 0);
   assert(pthread_mutex_destroy(&gate2) == 0);
   assert(pthread_mutex_destroy(&gate1) == 0);
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-  printf( "%-45s %15ld %15.3f\n",
-          testNameString,
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS / 4   /* Four locks/unlocks per iteration */);
+  result.threads = 2;
+  benchPrintResult(testNameString, &result);
 }
 
 
@@ -151,28 +131,9 @@ int pthread_test_bench2()
 
   printf( "=============================================================================\n");
   printf( "\nLock plus unlock on a locked mutex.\n");
-  printf("%ld iterations, four locks/unlocks per iteration.\n\n", ITERATIONS);
-
-  printf( "%-45s %15s %15s\n",
-          "Test",
-          "Total(msec)",
-          "average(usec)");
-
-  /*
-   * Time the loop overhead so we can subtract it from the actual test times.
-   */
-
-  running = 1;
-  assert(pthread_create(&worker, NULL, overheadThread, NULL) == 0);
-  TESTSTART
-  sched_yield();
-  sched_yield();
-  TESTSTOP
-  running = 0;
-  assert(pthread_join(worker, NULL) == 0);
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-  overHeadMilliSecs = durationMilliSecs;
+  printf( "Per-iteration time over %d runs, four locks/unlocks per iteration.\n\n", BENCH_RUNS);
 
+  benchPrintHeader();
 
   /*
    * Now we can start the actual tests
@@ -54,35 +54,26 @@
 #include "benchtest.h"
 
 #define PTW32_MUTEX_TYPES
-#define ITERATIONS      100000L
 
 static pthread_mutex_t mx;
 static pthread_mutexattr_t ma;
-static struct _timeb currSysTimeStart;
-static struct _timeb currSysTimeStop;
-static long durationMilliSecs;
-static long overHeadMilliSecs = 0;
 
-#define GetDurationMilliSecs(_TStart, _TStop) ((_TStop.time*1000+_TStop.millitm) \
-                                               - (_TStart.time*1000+_TStart.millitm))
 
-/*
- * Dummy use of j, otherwise the loop may be removed by the optimiser
- * when doing the overhead timing with an empty loop.
- */
-#define TESTSTART \
-  { int i, j = 0, k = 0; _ftime(&currSysTimeStart); for (i = 0; i < ITERATIONS; i++) { j++;
-
-#define TESTSTOP \
-  }; _ftime(&currSysTimeStop); if (j + k == i) j++; }
+static void
+trylockOp (void * arg, long iterations)
+{
+  long i;
 
+  for (i = 0; i < iterations; i++)
+    {
+      (void) pthread_mutex_trylock(&mx);
+    }
+}
 
 static void *
 trylockThread (void * arg)
 {
-  TESTSTART
-  (void) pthread_mutex_trylock(&mx);
-  TESTSTOP
+  benchRun(trylockOp, NULL, (benchResult *) arg);
 
   return NULL;
 }
@@ -92,23 +83,19 @@ static void
 runTest (char * testNameString, int mType)
 {
   pthread_t t;
+  benchResult result;
 
 #ifdef PTW32_MUTEX_TYPES
   (void) pthread_mutexattr_settype(&ma, mType);
 #endif
   assert(pthread_mutex_init(&mx, &ma) == 0);
   assert(pthread_mutex_lock(&mx) == 0);
-  assert(pthread_create(&t, NULL, trylockThread, 0) == 0);
+  assert(pthread_create(&t, NULL, trylockThread, (void *) &result) == 0);
   assert(pthread_join(t, NULL) == 0);
   assert(pthread_mutex_unlock(&mx) == 0);
   assert(pthread_mutex_destroy(&mx) == 0);
 
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-
-  printf( "%-45s %15ld %15.3f\n",
-          testNameString,
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS);
+  benchPrintResult(testNameString, &result);
 }
 
 
@@ -118,22 +105,8 @@ int pthread_test_bench3()
 
   printf( "=============================================================================\n");
   printf( "\nTrylock on a locked mutex.\n");
-  printf( "%ld iterations.\n\n", ITERATIONS);
-  printf( "%-45s %15s %15s\n",
-          "Test",
-          "Total(msec)",
-          "average(usec)");
-
-  /*
-   * Time the loop overhead so we can subtract it from the actual test times.
-   */
-
-  TESTSTART
-  TESTSTOP
-
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-  overHeadMilliSecs = durationMilliSecs;
-
+  printf( "Per-operation time over %d runs.\n\n", BENCH_RUNS);
+  benchPrintHeader();
 
   printf( ".............................................................................\n");
 
@@ -141,13 +114,13 @@ int pthread_test_bench3()
    * Now we can start the actual tests
    */
 #ifdef PTW32_MUTEX_TYPES
-  runTest("PTHREAD_MUTEX_DEFAULT (W9x,WNT)", PTHREAD_MUTEX_DEFAULT);
+  runTest("PTHREAD_MUTEX_DEFAULT", PTHREAD_MUTEX_DEFAULT);
 
-  runTest("PTHREAD_MUTEX_NORMAL (W9x,WNT)", PTHREAD_MUTEX_NORMAL);
+  runTest("PTHREAD_MUTEX_NORMAL", PTHREAD_MUTEX_NORMAL);
 
-  runTest("PTHREAD_MUTEX_ERRORCHECK (W9x,WNT)", PTHREAD_MUTEX_ERRORCHECK);
+  runTest("PTHREAD_MUTEX_ERRORCHECK", PTHREAD_MUTEX_ERRORCHECK);
 
-  runTest("PTHREAD_MUTEX_RECURSIVE (W9x,WNT)", PTHREAD_MUTEX_RECURSIVE);
+  runTest("PTHREAD_MUTEX_RECURSIVE", PTHREAD_MUTEX_RECURSIVE);
 #else
   runTest("Non-blocking lock", 0);
 #endif
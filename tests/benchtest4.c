@@ -54,50 +54,38 @@
 #include "benchtest.h"
 
 #define PTW32_MUTEX_TYPES
-#define ITERATIONS      100000L
 
 static pthread_mutex_t mx;
 static pthread_mutexattr_t ma;
-static struct _timeb currSysTimeStart;
-static struct _timeb currSysTimeStop;
-static long durationMilliSecs;
-static long overHeadMilliSecs = 0;
 
-#define GetDurationMilliSecs(_TStart, _TStop) ((_TStop.time*1000+_TStop.millitm) \
-                                               - (_TStart.time*1000+_TStart.millitm))
 
-/*
- * Dummy use of j, otherwise the loop may be removed by the optimiser
- * when doing the overhead timing with an empty loop.
- */
-#define TESTSTART \
-  { int i, j = 0, k = 0; _ftime(&currSysTimeStart); for (i = 0; i < ITERATIONS; i++) { j++;
-
-#define TESTSTOP \
-  }; _ftime(&currSysTimeStop); if (j + k == i) j++; }
+static void
+trylockUnlockOp (void * arg, long iterations)
+{
+  long i;
 
+  for (i = 0; i < iterations; i++)
+    {
+      (void) pthread_mutex_trylock(&mx);
+      (void) pthread_mutex_unlock(&mx);
+    }
+}
 
 static void
 runTest (char * testNameString, int mType)
 {
+  benchResult result;
+
 #ifdef PTW32_MUTEX_TYPES
   pthread_mutexattr_settype(&ma, mType);
 #endif
   pthread_mutex_init(&mx, &ma);
 
-  TESTSTART
-  (void) pthread_mutex_trylock(&mx);
-  (void) pthread_mutex_unlock(&mx);
-  TESTSTOP
+  benchRun(trylockUnlockOp, NULL, &result);
 
   pthread_mutex_destroy(&mx);
 
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-
-  printf( "%-45s %15ld %15.3f\n",
-          testNameString,
-          durationMilliSecs,
-          (float) durationMilliSecs * 1E3 / ITERATIONS);
+  benchPrintResult(testNameString, &result);
 }
 
 
@@ -107,21 +95,8 @@ int pthread_test_bench4()
 
   printf( "=============================================================================\n");
   printf( "Trylock plus unlock on an unlocked mutex.\n");
-  printf( "%ld iterations.\n\n", ITERATIONS);
-  printf( "%-45s %15s %15s\n",
-          "Test",
-          "Total(msec)",
-          "average(usec)");
-
-  /*
-   * Time the loop overhead so we can subtract it from the actual test times.
-   */
-
-  TESTSTART
-  TESTSTOP
-
-  durationMilliSecs = GetDurationMilliSecs(currSysTimeStart, currSysTimeStop) - overHeadMilliSecs;
-  overHeadMilliSecs = durationMilliSecs;
+  printf( "Per-operation time over %d runs.\n\n", BENCH_RUNS);
+  benchPrintHeader();
 
   /*
    * Now we can start the actual tests
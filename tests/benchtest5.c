@@ -0,0 +1,213 @@
+/*
+ * benchtest5.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure time taken to complete an elementary operation.
+ *
+ * - Mutex
+ *   Several threads transfer between randomly chosen pairs of
+ *   shared accounts, each guarded by its own mutex, comparing
+ *   strategies for acquiring both locks without deadlock.
+ */
+
+#include "test.h"
+
+#ifdef __GNUC__
+#include <stdlib.h>
+#endif
+
+#include "benchtest.h"
+
+#define NUMTHREADS      4
+#define ACCOUNTS        8
+
+typedef void (*transferFunc)(int from, int to);
+
+static pthread_mutex_t accountLock[ACCOUNTS];
+static int balance[ACCOUNTS];
+static transferFunc transfer;
+static long transfersPerThread;
+
+/*
+ * Lock both mutexes in address order, blocking on each.
+ */
+static void
+orderedTransfer(int from, int to)
+{
+  pthread_mutex_t * first = &accountLock[from];
+  pthread_mutex_t * second = &accountLock[to];
+
+  if (*second < *first)
+    {
+      first = &accountLock[to];
+      second = &accountLock[from];
+    }
+
+  (void) pthread_mutex_lock(first);
+  (void) pthread_mutex_lock(second);
+  balance[from]--;
+  balance[to]++;
+  (void) pthread_mutex_unlock(second);
+  (void) pthread_mutex_unlock(first);
+}
+
+/*
+ * Lock the first mutex, try the second and back off
+ * and yield under contention.
+ */
+static void
+backoffTransfer(int from, int to)
+{
+  for (;;)
+    {
+      (void) pthread_mutex_lock(&accountLock[from]);
+
+      if (pthread_mutex_trylock(&accountLock[to]) == 0)
+        {
+          break;
+        }
+
+      (void) pthread_mutex_unlock(&accountLock[from]);
+      sched_yield();
+    }
+
+  balance[from]--;
+  balance[to]++;
+  (void) pthread_mutex_unlock(&accountLock[to]);
+  (void) pthread_mutex_unlock(&accountLock[from]);
+}
+
+static void
+lockManyTransfer(int from, int to)
+{
+  pthread_mutex_t * set[2];
+
+  set[0] = &accountLock[from];
+  set[1] = &accountLock[to];
+
+  (void) pthread_mutex_lock_many_np(set, 2);
+  balance[from]--;
+  balance[to]++;
+  (void) pthread_mutex_unlock_many_np(set, 2);
+}
+
+static void *
+transferThread(void * arg)
+{
+  unsigned int seed = (unsigned int) (size_t) arg * 2654435761U + 1;
+  long i;
+
+  for (i = 0; i < transfersPerThread; i++)
+    {
+      int from, to;
+
+      seed = seed * 1103515245 + 12345;
+      from = (seed >> 16) % ACCOUNTS;
+      seed = seed * 1103515245 + 12345;
+      to = (seed >> 16) % (ACCOUNTS - 1);
+
+      if (to >= from)
+        {
+          to++;
+        }
+
+      transfer(from, to);
+    }
+
+  return NULL;
+}
+
+/*
+ * One iteration is one transfer on each of NUMTHREADS concurrent threads.
+ */
+static void
+transferOp (void * arg, long iterations)
+{
+  pthread_t t[NUMTHREADS];
+  int i;
+
+  transfersPerThread = iterations;
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, transferThread, (void *) (size_t) i) == 0);
+    }
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+}
+
+static void
+runTest (char * testNameString, transferFunc func)
+{
+  benchResult result;
+  int i, total = 0;
+
+  for (i = 0; i < ACCOUNTS; i++)
+    {
+      assert(pthread_mutex_init(&accountLock[i], NULL) == 0);
+      balance[i] = 0;
+    }
+
+  transfer = func;
+
+  benchRun(transferOp, NULL, &result);
+
+  for (i = 0; i < ACCOUNTS; i++)
+    {
+      total += balance[i];
+      assert(pthread_mutex_destroy(&accountLock[i]) == 0);
+    }
+
+  assert(total == 0);
+
+  result.threads = NUMTHREADS;
+  benchPrintResult(testNameString, &result);
+}
+
+
+int pthread_test_bench5()
+{
+  printf( "=============================================================================\n");
+  printf( "\nTransfers between random pairs of %d mutex-guarded accounts.\n", ACCOUNTS);
+  printf( "%d threads, per-iteration time over %d runs, one transfer per thread per iteration.\n\n",
+          NUMTHREADS, BENCH_RUNS);
+
+  benchPrintHeader();
+
+  runTest("Address ordered lock", orderedTransfer);
+
+  runTest("Trylock with yield back-off", backoffTransfer);
+
+  runTest("pthread_mutex_lock_many_np", lockManyTransfer);
+
+  printf( "=============================================================================\n");
+
+  return 0;
+}
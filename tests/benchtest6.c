@@ -0,0 +1,460 @@
+/*
+ * benchtest6.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure throughput and fairness under contention.
+ *
+ * - Mutex (each kind), spinlock, rwlock, semaphore
+ *   1..MAX_THREADS threads repeatedly acquire a shared object, spend
+ *   CS_WORK units inside the critical section and THINK_WORK units
+ *   outside it. The rwlock is run with several read/write mixes.
+ *
+ * - Condition variable
+ *   Threads pass a token round-robin, each waiting on a shared
+ *   condition variable for its turn.
+ *
+ * Throughput is total acquisitions per second over RUN_MSECS. Spread
+ * is (max - min) per-thread acquisitions as a percentage of the mean;
+ * 0% is perfectly fair.
+ */
+
+#include "test.h"
+
+#ifdef __GNUC__
+#include <stdlib.h>
+#endif
+
+#include "benchtest.h"
+
+#ifndef MAX_THREADS
+#define MAX_THREADS     4
+#endif
+
+#ifndef RUN_MSECS
+#define RUN_MSECS       100
+#endif
+
+#ifndef CS_WORK
+#define CS_WORK         50
+#endif
+
+#ifndef THINK_WORK
+#define THINK_WORK      200
+#endif
+
+typedef struct
+  {
+    void (*init)(void);
+    void (*acquire)(int write);
+    void (*release)(int write);
+    void (*destroy)(void);
+  } primitive_t;
+
+static pthread_mutex_t mx;
+static pthread_spinlock_t spin;
+static pthread_rwlock_t rwl;
+static sem_t sem;
+static pthread_cond_t cv;
+
+static int mutexType;
+static int readPercent;
+static int turn;
+static int ringSize;
+static volatile int stop;
+static pthread_barrier_t startBarrier;
+static long counts[MAX_THREADS];
+
+static void
+work(int units)
+{
+  volatile int j = 0;
+  int i;
+
+  for (i = 0; i < units; i++)
+    {
+      j++;
+    }
+}
+
+
+static void
+mutexInit(void)
+{
+  pthread_mutexattr_t ma;
+
+  assert(pthread_mutexattr_init(&ma) == 0);
+  assert(pthread_mutexattr_settype(&ma, mutexType) == 0);
+  assert(pthread_mutex_init(&mx, &ma) == 0);
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+}
+
+static void
+mutexAcquire(int write)
+{
+  (void) pthread_mutex_lock(&mx);
+}
+
+static void
+mutexRelease(int write)
+{
+  (void) pthread_mutex_unlock(&mx);
+}
+
+static void
+mutexDestroy(void)
+{
+  assert(pthread_mutex_destroy(&mx) == 0);
+}
+
+static void
+spinInit(void)
+{
+  assert(pthread_spin_init(&spin, PTHREAD_PROCESS_PRIVATE) == 0);
+}
+
+static void
+spinAcquire(int write)
+{
+  (void) pthread_spin_lock(&spin);
+}
+
+static void
+spinRelease(int write)
+{
+  (void) pthread_spin_unlock(&spin);
+}
+
+static void
+spinDestroy(void)
+{
+  assert(pthread_spin_destroy(&spin) == 0);
+}
+
+static void
+rwlockInit(void)
+{
+  assert(pthread_rwlock_init(&rwl, NULL) == 0);
+}
+
+static void
+rwlockAcquire(int write)
+{
+  if (write)
+    {
+      (void) pthread_rwlock_wrlock(&rwl);
+    }
+  else
+    {
+      (void) pthread_rwlock_rdlock(&rwl);
+    }
+}
+
+static void
+rwlockRelease(int write)
+{
+  (void) pthread_rwlock_unlock(&rwl);
+}
+
+static void
+rwlockDestroy(void)
+{
+  assert(pthread_rwlock_destroy(&rwl) == 0);
+}
+
+static void
+semInit(void)
+{
+  assert(sem_init(&sem, 0, 1) == 0);
+}
+
+static void
+semAcquire(int write)
+{
+  (void) sem_wait(&sem);
+}
+
+static void
+semRelease(int write)
+{
+  (void) sem_post(&sem);
+}
+
+static void
+semDestroy(void)
+{
+  assert(sem_destroy(&sem) == 0);
+}
+
+static primitive_t mutexPrimitive =
+  { mutexInit, mutexAcquire, mutexRelease, mutexDestroy };
+static primitive_t spinPrimitive =
+  { spinInit, spinAcquire, spinRelease, spinDestroy };
+static primitive_t rwlockPrimitive =
+  { rwlockInit, rwlockAcquire, rwlockRelease, rwlockDestroy };
+static primitive_t semPrimitive =
+  { semInit, semAcquire, semRelease, semDestroy };
+
+static primitive_t * primitive;
+
+
+static void *
+contender(void * arg)
+{
+  int self = (int) (size_t) arg;
+  long n = 0;
+
+  pthread_barrier_wait(&startBarrier);
+
+  while (!stop)
+    {
+      /*
+       * 37 is coprime to 100, so writes are spread evenly
+       * through each run of 100 operations.
+       */
+      int write = (int) ((n * 37) % 100) >= readPercent;
+
+      primitive->acquire(write);
+      work(CS_WORK);
+      primitive->release(write);
+      n++;
+      work(THINK_WORK);
+    }
+
+  counts[self] = n;
+
+  return NULL;
+}
+
+static void *
+pingPong(void * arg)
+{
+  int self = (int) (size_t) arg;
+  long n = 0;
+
+  pthread_barrier_wait(&startBarrier);
+
+  assert(pthread_mutex_lock(&mx) == 0);
+
+  while (!stop)
+    {
+      while (turn != self && !stop)
+        {
+          assert(pthread_cond_wait(&cv, &mx) == 0);
+        }
+
+      if (!stop)
+        {
+          turn = (turn + 1) % ringSize;
+          n++;
+          assert(pthread_cond_broadcast(&cv) == 0);
+        }
+    }
+
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  counts[self] = n;
+
+  return NULL;
+}
+
+static void
+report(const char * testNameString, int nthreads, unsigned long long elapsedNs)
+{
+  benchResult result;
+  long total = 0, min = counts[0], max = counts[0];
+  double mean;
+  int i;
+
+  for (i = 0; i < nthreads; i++)
+    {
+      total += counts[i];
+
+      if (counts[i] < min)
+        {
+          min = counts[i];
+        }
+
+      if (counts[i] > max)
+        {
+          max = counts[i];
+        }
+    }
+
+  mean = (double) total / nthreads;
+
+  printf( "%-30s %7d %12.0f %10ld %10ld %8.1f\n",
+          testNameString,
+          nthreads,
+          (double) total * 1E9 / elapsedNs,
+          min,
+          max,
+          mean > 0.0 ? (max - min) * 100.0 / mean : 0.0);
+
+  /*
+   * For the machine-readable report: wall time per acquisition.
+   */
+  result.iterations = total;
+  result.threads = nthreads;
+  result.runs = 1;
+  result.minNs = result.medianNs = result.p99Ns = result.meanNs =
+    total > 0 ? (double) elapsedNs / total : 0.0;
+  result.stddevNs = 0.0;
+  benchRecord(testNameString, &result);
+}
+
+static void
+runThreads(const char * testNameString, int nthreads, void * (*threadFunc)(void *))
+{
+  pthread_t t[MAX_THREADS];
+  unsigned long long start;
+  int i;
+
+  stop = 0;
+  ringSize = nthreads;
+  assert(pthread_barrier_init(&startBarrier, NULL, nthreads + 1) == 0);
+
+  for (i = 0; i < nthreads; i++)
+    {
+      assert(pthread_create(&t[i], NULL, threadFunc, (void *) (size_t) i) == 0);
+    }
+
+  pthread_barrier_wait(&startBarrier);
+  start = pte_osClockGetNanoseconds();
+
+  pte_osThreadSleep(RUN_MSECS);
+
+  stop = 1;
+
+  if (threadFunc == pingPong)
+    {
+      /*
+       * A lone ping-pong thread never waits, so it must see 'stop'
+       * before we can take the mutex to wake any waiters.
+       */
+      assert(pthread_mutex_lock(&mx) == 0);
+      assert(pthread_cond_broadcast(&cv) == 0);
+      assert(pthread_mutex_unlock(&mx) == 0);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(pthread_barrier_destroy(&startBarrier) == 0);
+
+  report(testNameString, nthreads, pte_osClockGetNanoseconds() - start);
+}
+
+static void
+runTest (const char * testNameString, primitive_t * p)
+{
+  int nthreads;
+
+  primitive = p;
+  primitive->init();
+
+  for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2)
+    {
+      runThreads(testNameString, nthreads, contender);
+    }
+
+  primitive->destroy();
+}
+
+static void
+runMutexTest (const char * testNameString, int mType)
+{
+  mutexType = mType;
+  readPercent = 0;
+  runTest(testNameString, &mutexPrimitive);
+}
+
+static void
+runRwlockTest (const char * testNameString, int percent)
+{
+  readPercent = percent;
+  runTest(testNameString, &rwlockPrimitive);
+}
+
+static void
+runPingPongTest (const char * testNameString)
+{
+  int nthreads;
+
+  assert(pthread_mutex_init(&mx, NULL) == 0);
+  assert(pthread_cond_init(&cv, NULL) == 0);
+
+  for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2)
+    {
+      turn = 0;
+      runThreads(testNameString, nthreads, pingPong);
+    }
+
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+}
+
+
+int pthread_test_bench6()
+{
+  printf( "=============================================================================\n");
+  printf( "\nContended acquire/release, %d ms per run.\n", RUN_MSECS);
+  printf( "Critical section %d, think time %d work units.\n\n", CS_WORK, THINK_WORK);
+
+  printf( "%-30s %7s %12s %10s %10s %8s\n",
+          "Test",
+          "Threads",
+          "ops/sec",
+          "min/thread",
+          "max/thread",
+          "spread%");
+
+  printf( ".............................................................................\n");
+
+  runMutexTest("PTHREAD_MUTEX_DEFAULT", PTHREAD_MUTEX_DEFAULT);
+  runMutexTest("PTHREAD_MUTEX_NORMAL", PTHREAD_MUTEX_NORMAL);
+  runMutexTest("PTHREAD_MUTEX_ERRORCHECK", PTHREAD_MUTEX_ERRORCHECK);
+  runMutexTest("PTHREAD_MUTEX_RECURSIVE", PTHREAD_MUTEX_RECURSIVE);
+
+  readPercent = 0;
+  runTest("Spinlock", &spinPrimitive);
+
+  runRwlockTest("Rwlock 100% read", 100);
+  runRwlockTest("Rwlock 90% read", 90);
+  runRwlockTest("Rwlock 50% read", 50);
+  runRwlockTest("Rwlock 100% write", 0);
+
+  readPercent = 0;
+  runTest("Semaphore (binary)", &semPrimitive);
+
+  runPingPongTest("Condvar ping-pong");
+
+  printf( "=============================================================================\n");
+
+  return 0;
+}
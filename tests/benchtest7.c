@@ -0,0 +1,327 @@
+/*
+ * benchtest7.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure thread lifecycle latency.
+ *
+ * - Create
+ *   Time from calling pthread_create() to the first instruction of the
+ *   new thread, split by whether the pthread_t came off the reuse
+ *   stack or was freshly allocated. Threads are created in growing
+ *   bursts so that both cases occur.
+ *
+ * - Join
+ *   Time from the last instruction of a thread to pthread_join()
+ *   returning in a thread already blocked in it.
+ *
+ * - Throughput
+ *   Joinable create/join and detached create/exit cycles per second.
+ */
+
+#include "test.h"
+
+#ifdef __GNUC__
+#include <stdlib.h>
+#endif
+
+#include "benchtest.h"
+
+#define SAMPLES         200
+#define MAX_BURST       8
+#define MAX_SEEN        64
+#define CYCLES          256
+
+typedef struct
+  {
+    volatile unsigned long long startNs;
+    sem_t * gate;
+  } bag_t;
+
+static bag_t bags[MAX_BURST];
+static sem_t gate;
+static sem_t done;
+
+static pthread_t seen[MAX_SEEN];
+static int numSeen;
+
+static double reusedSamples[SAMPLES];
+static double freshSamples[SAMPLES];
+static double joinSamples[SAMPLES];
+
+
+/*
+ * Returns 1 if this pthread_t has been handed out before,
+ * i.e. its struct came off the reuse stack.
+ */
+static int
+wasSeen(pthread_t t)
+{
+  int i;
+
+  for (i = 0; i < numSeen; i++)
+    {
+      /*
+       * Not pthread_equal(): a joined thread's pthread_t no longer
+       * compares equal to anything.
+       */
+      if (seen[i] == t)
+        {
+          return 1;
+        }
+    }
+
+  if (numSeen < MAX_SEEN)
+    {
+      seen[numSeen++] = t;
+    }
+
+  return 0;
+}
+
+static void *
+startFunc(void * arg)
+{
+  bag_t * bag = (bag_t *) arg;
+
+  bag->startNs = pte_osClockGetNanoseconds();
+
+  if (bag->gate != NULL)
+    {
+      assert(sem_wait(bag->gate) == 0);
+    }
+
+  return NULL;
+}
+
+static void *
+exitFunc(void * arg)
+{
+  bag_t * bag = (bag_t *) arg;
+
+  assert(sem_wait(bag->gate) == 0);
+
+  /*
+   * Give the main thread time to block in pthread_join().
+   */
+  pte_osThreadSleep(1);
+
+  bag->startNs = pte_osClockGetNanoseconds();
+
+  return NULL;
+}
+
+static void *
+nullFunc(void * arg)
+{
+  return NULL;
+}
+
+static void *
+detachedFunc(void * arg)
+{
+  assert(sem_post(&done) == 0);
+
+  return NULL;
+}
+
+static void
+createLatency(int * numReused, int * numFresh)
+{
+  pthread_t t[MAX_BURST];
+  unsigned long long createNs[MAX_BURST];
+  int burst = 1;
+  int i;
+
+  *numReused = 0;
+  *numFresh = 0;
+
+  while (*numReused + MAX_BURST <= SAMPLES && *numFresh + MAX_BURST <= SAMPLES)
+    {
+      for (i = 0; i < burst; i++)
+        {
+          bags[i].gate = &gate;
+          createNs[i] = pte_osClockGetNanoseconds();
+          assert(pthread_create(&t[i], NULL, startFunc, (void *) &bags[i]) == 0);
+        }
+
+      assert(sem_post_multiple(&gate, burst) == 0);
+
+      for (i = 0; i < burst; i++)
+        {
+          double ns;
+
+          assert(pthread_join(t[i], NULL) == 0);
+
+          ns = (double) (bags[i].startNs - createNs[i]);
+
+          if (wasSeen(t[i]))
+            {
+              reusedSamples[(*numReused)++] = ns;
+            }
+          else
+            {
+              freshSamples[(*numFresh)++] = ns;
+            }
+        }
+
+      /*
+       * Grow the burst past the size of the reuse stack until
+       * MAX_BURST, then keep cycling through reused structs.
+       */
+      if (burst < MAX_BURST)
+        {
+          burst *= 2;
+        }
+    }
+}
+
+static void
+joinLatency(void)
+{
+  pthread_t t;
+  bag_t bag;
+  int i;
+
+  bag.gate = &gate;
+
+  for (i = 0; i < SAMPLES; i++)
+    {
+      assert(pthread_create(&t, NULL, exitFunc, (void *) &bag) == 0);
+      assert(sem_post(&gate) == 0);
+      assert(pthread_join(t, NULL) == 0);
+      joinSamples[i] = (double) (pte_osClockGetNanoseconds() - bag.startNs);
+    }
+}
+
+static void
+joinableOp(void * arg, long iterations)
+{
+  pthread_t t;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      assert(pthread_create(&t, NULL, nullFunc, NULL) == 0);
+      assert(pthread_join(t, NULL) == 0);
+    }
+}
+
+/*
+ * Detached threads are created in waves of MAX_BURST so the number
+ * alive at once stays within the OS limit.
+ */
+static double
+detachedThroughput(void)
+{
+  pthread_attr_t attr;
+  pthread_t t;
+  unsigned long long start;
+  int i, j;
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) == 0);
+
+  start = pte_osClockGetNanoseconds();
+
+  for (i = 0; i < CYCLES; i += MAX_BURST)
+    {
+      for (j = 0; j < MAX_BURST; j++)
+        {
+          assert(pthread_create(&t, &attr, detachedFunc, NULL) == 0);
+        }
+
+      for (j = 0; j < MAX_BURST; j++)
+        {
+          assert(sem_wait(&done) == 0);
+        }
+    }
+
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  return (double) CYCLES * 1E9 / (pte_osClockGetNanoseconds() - start);
+}
+
+static void
+printDistribution(const char * testNameString, double * samples, int count)
+{
+  benchResult result;
+
+  if (count == 0)
+    {
+      printf( "%-40s %10s\n", testNameString, "-");
+      return;
+    }
+
+  benchSummarise(samples, count, &result);
+  benchPrintResult(testNameString, &result);
+}
+
+
+int pthread_test_bench7()
+{
+  benchResult result;
+  int numReused, numFresh;
+  double detachedRate;
+
+  numSeen = 0;
+
+  assert(sem_init(&gate, 0, 0) == 0);
+  assert(sem_init(&done, 0, 0) == 0);
+
+  createLatency(&numReused, &numFresh);
+  joinLatency();
+  benchRun(joinableOp, NULL, &result);
+  detachedRate = detachedThroughput();
+
+  printf( "=============================================================================\n");
+  printf( "\nThread lifecycle latency.\n");
+  printf( "%d reused and %d fresh create samples, %d join samples.\n\n",
+          numReused, numFresh, SAMPLES);
+  benchPrintHeader();
+
+  printDistribution("Create to start (reused pthread_t)", reusedSamples, numReused);
+  printDistribution("Create to start (fresh pthread_t)", freshSamples, numFresh);
+  printDistribution("Exit to join return", joinSamples, SAMPLES);
+  benchPrintResult("Joinable create + join", &result);
+
+  printf( ".............................................................................\n");
+
+  printf( "%-40s %10.0f\n", "Joinable create + join (threads/sec)", 1E9 / result.medianNs);
+  printf( "%-40s %10.0f\n", "Detached create + exit (threads/sec)", detachedRate);
+
+  result.minNs = result.medianNs = result.p99Ns = result.meanNs = 1E9 / detachedRate;
+  result.stddevNs = 0.0;
+  result.iterations = CYCLES;
+  benchRecord("Detached create + exit", &result);
+
+  printf( "=============================================================================\n");
+
+  assert(sem_destroy(&done) == 0);
+  assert(sem_destroy(&gate) == 0);
+
+  return 0;
+}
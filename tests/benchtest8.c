@@ -0,0 +1,158 @@
+/*
+ * benchtest8.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure the cost of barriers.
+ *
+ * - Init + destroy
+ *   Creating and destroying a barrier, as done for short-lived
+ *   per-job barriers.
+ *
+ * - Round trip
+ *   Time for two threads to pass the same barrier once, measured
+ *   from one thread over many consecutive rounds.
+ *
+ * - Memory
+ *   Heap bytes and number of allocations per barrier, counted
+ *   only when the test program provides BENCH_HEAP_COUNTERS.
+ */
+
+#include "test.h"
+#include "benchtest.h"
+
+#define ROUNDS          2000
+
+static pthread_barrier_t barrier;
+static double roundSamples[ROUNDS];
+
+static void
+initDestroyOp(void * arg, long iterations)
+{
+  pthread_barrier_t b;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      assert(pthread_barrier_init(&b, NULL, 2) == 0);
+      assert(pthread_barrier_destroy(&b) == 0);
+    }
+}
+
+static void *
+partnerFunc(void * arg)
+{
+  int i;
+
+  for (i = 0; i <= ROUNDS; i++)
+    {
+      pthread_barrier_wait(&barrier);
+    }
+
+  return NULL;
+}
+
+static void
+roundTrip(void)
+{
+  pthread_t t;
+  unsigned long long last;
+  unsigned long long now;
+  int i;
+
+  assert(pthread_barrier_init(&barrier, NULL, 2) == 0);
+  assert(pthread_create(&t, NULL, partnerFunc, NULL) == 0);
+
+  pthread_barrier_wait(&barrier);
+  last = pte_osClockGetNanoseconds();
+
+  for (i = 0; i < ROUNDS; i++)
+    {
+      pthread_barrier_wait(&barrier);
+      now = pte_osClockGetNanoseconds();
+      roundSamples[i] = (double) (now - last);
+      last = now;
+    }
+
+  assert(pthread_join(t, NULL) == 0);
+  assert(pthread_barrier_destroy(&barrier) == 0);
+}
+
+#ifdef BENCH_HEAP_COUNTERS
+/*
+ * Provided by a test program that wraps the allocator.
+ */
+extern long benchHeapBytes;
+extern long benchHeapAllocs;
+
+static void
+heapUsage(long * bytes, long * allocs)
+{
+  pthread_barrier_t b;
+  long startBytes = benchHeapBytes;
+  long startAllocs = benchHeapAllocs;
+
+  assert(pthread_barrier_init(&b, NULL, 2) == 0);
+  *bytes = benchHeapBytes - startBytes;
+  *allocs = benchHeapAllocs - startAllocs;
+  assert(pthread_barrier_destroy(&b) == 0);
+}
+#endif
+
+
+int pthread_test_bench8()
+{
+  benchResult initResult;
+  benchResult roundResult;
+
+  benchRun(initDestroyOp, NULL, &initResult);
+  roundTrip();
+  benchSummarise(roundSamples, ROUNDS, &roundResult);
+  roundResult.threads = 2;
+
+  printf( "=============================================================================\n");
+  printf( "\nBarrier cost.\n\n");
+  benchPrintHeader();
+
+  benchPrintResult("Barrier init + destroy", &initResult);
+  benchPrintResult("Barrier round trip (2 threads)", &roundResult);
+
+#ifdef BENCH_HEAP_COUNTERS
+  {
+    long bytes, allocs;
+
+    heapUsage(&bytes, &allocs);
+
+    printf( ".............................................................................\n");
+    printf( "%-40s %10ld\n", "Barrier heap bytes", bytes);
+    printf( "%-40s %10ld\n", "Barrier heap allocations", allocs);
+  }
+#endif
+
+  printf( "=============================================================================\n");
+
+  return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * benchtest9.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Measure the cost of timed semaphore waits.
+ *
+ * - Available semaphore
+ *   sem_timedwait() and sem_reltimedwait_np() on a semaphore that can
+ *   be taken at once, against sem_trywait(). Each take is paired with
+ *   a sem_post(). No timeout is needed, so none should be computed.
+ *
+ * - Expired timeout
+ *   sem_timedwait() with a deadline in the past on a semaphore that is
+ *   never posted: the cost of turning a deadline into a timeout.
+ *
+ * - Clocks
+ *   ftime(), which deadlines used to be measured with, and the OSAL
+ *   monotonic clock they are now derived from.
+ */
+
+#include "test.h"
+#include "benchtest.h"
+
+static sem_t sem;
+
+static void
+tryWaitOp(void * arg, long iterations)
+{
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      sem_post(&sem);
+      sem_trywait(&sem);
+    }
+}
+
+static void
+timedWaitOp(void * arg, long iterations)
+{
+  const struct timespec * abstime = (const struct timespec *) arg;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      sem_post(&sem);
+      sem_timedwait(&sem, abstime);
+    }
+}
+
+static void
+relTimedWaitOp(void * arg, long iterations)
+{
+  const struct timespec * reltime = (const struct timespec *) arg;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      sem_post(&sem);
+      sem_reltimedwait_np(&sem, reltime);
+    }
+}
+
+static void
+expiredOp(void * arg, long iterations)
+{
+  const struct timespec * abstime = (const struct timespec *) arg;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      sem_timedwait(&sem, abstime);
+    }
+}
+
+static void
+ftimeOp(void * arg, long iterations)
+{
+  struct timeb currSysTime;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      _ftime(&currSysTime);
+    }
+}
+
+static void
+fastClockOp(void * arg, long iterations)
+{
+  volatile unsigned long long now;
+  long i;
+
+  for (i = 0; i < iterations; i++)
+    {
+      now = pte_osClockGetNanoseconds();
+    }
+}
+
+
+int pthread_test_bench9()
+{
+  struct timespec future;
+  struct timespec past;
+  struct timespec reltime;
+  struct timeb currSysTime;
+  benchResult tryResult;
+  benchResult timedResult;
+  benchResult relResult;
+  benchResult expiredResult;
+  benchResult ftimeResult;
+  benchResult fastResult;
+
+  _ftime(&currSysTime);
+  future.tv_sec = currSysTime.time + 3600;
+  future.tv_nsec = 0;
+  past.tv_sec = currSysTime.time - 3600;
+  past.tv_nsec = 0;
+  reltime.tv_sec = 3600;
+  reltime.tv_nsec = 0;
+
+  assert(sem_init(&sem, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+
+  benchRun(tryWaitOp, NULL, &tryResult);
+  benchRun(timedWaitOp, &future, &timedResult);
+  benchRun(relTimedWaitOp, &reltime, &relResult);
+  benchRun(expiredOp, &past, &expiredResult);
+  benchRun(ftimeOp, NULL, &ftimeResult);
+  benchRun(fastClockOp, NULL, &fastResult);
+
+  assert(sem_destroy(&sem) == 0);
+
+  printf( "=============================================================================\n");
+  printf( "\nTimed semaphore wait cost.\n\n");
+  benchPrintHeader();
+
+  benchPrintResult("sem_post + sem_trywait", &tryResult);
+  benchPrintResult("sem_post + sem_timedwait", &timedResult);
+  benchPrintResult("sem_post + sem_reltimedwait_np", &relResult);
+  benchPrintResult("sem_timedwait, deadline passed", &expiredResult);
+  benchPrintResult("ftime()", &ftimeResult);
+  benchPrintResult("pte_osClockGetNanoseconds()", &fastResult);
+
+  printf( "=============================================================================\n");
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * concurrency1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - pthread_setconcurrency() and mutexes that poll before blocking.
+ *
+ * Test Method (Validation or Falsification):
+ * - Validation
+ *
+ * Requirements Tested:
+ * - The level set is the level returned; negative levels are refused.
+ * - Contended mutexes of every kind stay exclusive whatever polling
+ *   budget the level gives them.
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * - The default level, one thread per CPU, and far more threads
+ *   than CPUs.
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+enum
+{
+  NUMTHREADS = 4,
+  ITERATIONS = 20000
+};
+
+static pthread_mutex_t mutex;
+static int inside;
+static int count;
+
+static void *
+func(void * arg)
+{
+  int i;
+
+  for (i = 0; i < ITERATIONS; i++)
+    {
+      assert(pthread_mutex_lock(&mutex) == 0);
+      assert(++inside == 1);
+      count++;
+      inside--;
+      assert(pthread_mutex_unlock(&mutex) == 0);
+    }
+
+  return 0;
+}
+
+int pthread_test_concurrency1()
+{
+  static const int levels[] = { 0, 1, 1000 };
+  static const int kinds[] =
+    {
+      PTHREAD_MUTEX_NORMAL,
+      PTHREAD_MUTEX_ERRORCHECK,
+      PTHREAD_MUTEX_RECURSIVE
+    };
+  pthread_mutexattr_t ma;
+  pthread_t t[NUMTHREADS];
+  int level = pthread_getconcurrency();
+  int i;
+  int j;
+  int k;
+
+  assert(pthread_setconcurrency(-1) == EINVAL);
+  assert(pthread_getconcurrency() == level);
+
+  assert(pthread_mutexattr_init(&ma) == 0);
+
+  for (i = 0; i < (int) (sizeof(levels) / sizeof(levels[0])); i++)
+    {
+      assert(pthread_setconcurrency(levels[i]) == 0);
+      assert(pthread_getconcurrency() == levels[i]);
+
+      for (j = 0; j < (int) (sizeof(kinds) / sizeof(kinds[0])); j++)
+        {
+          assert(pthread_mutexattr_settype(&ma, kinds[j]) == 0);
+          assert(pthread_mutex_init(&mutex, &ma) == 0);
+          count = 0;
+
+          for (k = 0; k < NUMTHREADS; k++)
+            {
+              assert(pthread_create(&t[k], NULL, func, NULL) == 0);
+            }
+
+          for (k = 0; k < NUMTHREADS; k++)
+            {
+              assert(pthread_join(t[k], NULL) == 0);
+            }
+
+          assert(count == NUMTHREADS * ITERATIONS);
+          assert(pthread_mutex_destroy(&mutex) == 0);
+        }
+    }
+
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+  assert(pthread_setconcurrency(level) == 0);
+
+  return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * condvar10.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test pthread_cond_timedwait_relative_np().
+ *
+ * Test Method (Validation or Falsification):
+ * - Validation
+ *
+ * Requirements Tested:
+ * - The wait lasts at least the interval when not signalled, and
+ *   the mutex is held again on every return.
+ *
+ * Features Tested:
+ * - Relative timeouts.
+ *
+ * Cases Tested:
+ * - Invalid interval.
+ * - Timeout.
+ * - Signal during the wait.
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * - The OS timer has a granularity of well under 50 milliseconds.
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+enum
+{
+  WAIT_MSECS = 100
+};
+
+static pthread_mutex_t mutex;
+static pthread_cond_t cv;
+static int signalled;
+
+static void *
+signaller(void * arg)
+{
+  pte_osThreadSleep(WAIT_MSECS);
+  assert(pthread_mutex_lock(&mutex) == 0);
+  signalled = 1;
+  assert(pthread_cond_signal(&cv) == 0);
+  assert(pthread_mutex_unlock(&mutex) == 0);
+
+  return 0;
+}
+
+int pthread_test_condvar10()
+{
+  pthread_mutexattr_t ma;
+  pthread_t t;
+  struct timespec reltime;
+  unsigned long long start;
+  unsigned long long waited;
+  int result;
+
+  signalled = 0;
+
+  /* Error checking, so unlocking shows the mutex is held on return. */
+  assert(pthread_mutexattr_init(&ma) == 0);
+  assert(pthread_mutexattr_settype(&ma, PTHREAD_MUTEX_ERRORCHECK) == 0);
+  assert(pthread_mutex_init(&mutex, &ma) == 0);
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+  assert(pthread_cond_init(&cv, NULL) == 0);
+
+  assert(pthread_mutex_lock(&mutex) == 0);
+
+  reltime.tv_sec = 0;
+  reltime.tv_nsec = 1000000000;
+  assert(pthread_cond_timedwait_relative_np(&cv, &mutex, &reltime) == EINVAL);
+  assert(pthread_cond_timedwait_relative_np(&cv, &mutex, NULL) == EINVAL);
+
+  reltime.tv_nsec = WAIT_MSECS * 1000000;
+  start = pte_osClockGetNanoseconds();
+  assert(pthread_cond_timedwait_relative_np(&cv, &mutex, &reltime) == ETIMEDOUT);
+  waited = (pte_osClockGetNanoseconds() - start) / 1000000;
+  assert(waited >= WAIT_MSECS - 1);
+
+  assert(pthread_create(&t, NULL, signaller, NULL) == 0);
+
+  reltime.tv_sec = 10;
+  reltime.tv_nsec = 0;
+  result = 0;
+  while (!signalled && result == 0)
+    {
+      result = pthread_cond_timedwait_relative_np(&cv, &mutex, &reltime);
+    }
+  assert(result == 0);
+
+  assert(pthread_mutex_unlock(&mutex) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(pthread_mutex_destroy(&mutex) == 0);
+
+  return 0;
+}
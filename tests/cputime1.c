@@ -0,0 +1,157 @@
+/*
+ * cputime1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Per-thread CPU time.
+ *
+ * Test Method (Validation or Falsification):
+ * - Validation
+ *
+ * Requirements Tested:
+ * - pthread_getcputime_np() charges CPU time to the thread that
+ *   used it, and reads it for threads other than the caller.
+ * - pthread_getcpuclockid() returns CLOCK_THREAD_CPUTIME_ID for
+ *   the calling thread and ENOENT for other threads.
+ *
+ * Features Tested:
+ * -
+ *
+ * Cases Tested:
+ * - A thread that spins and a thread that sleeps for the same time.
+ * - Invalid arguments.
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * - The OS accounts CPU time per thread; the test passes trivially
+ *   if it reports ENOTSUP.
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+enum
+{
+  RUN_MSECS = 50
+};
+
+static sem_t done;
+
+static void *
+spinner(void * arg)
+{
+  unsigned long long start = pte_osClockGetNanoseconds();
+
+  while (pte_osClockGetNanoseconds() - start < RUN_MSECS * 1000000ULL)
+    ;
+
+  assert(sem_wait(&done) == 0);
+
+  return 0;
+}
+
+static void *
+sleeper(void * arg)
+{
+  pte_osThreadSleep(RUN_MSECS);
+
+  assert(sem_wait(&done) == 0);
+
+  return 0;
+}
+
+static unsigned long long
+cpuMillisecs(pthread_t t)
+{
+  struct timespec cputime;
+
+  assert(pthread_getcputime_np(t, &cputime) == 0);
+
+  return (unsigned long long) cputime.tv_sec * 1000 + cputime.tv_nsec / 1000000;
+}
+
+int pthread_test_cputime1()
+{
+  pthread_t spinThread;
+  pthread_t sleepThread;
+  clockid_t clock;
+  struct timespec cputime;
+
+  if (pthread_getcputime_np(pthread_self(), &cputime) == ENOTSUP)
+    {
+      return 0;
+    }
+
+  assert(pthread_getcputime_np(pthread_self(), NULL) == EINVAL);
+  assert(pthread_getcpuclockid(pthread_self(), NULL) == EINVAL);
+
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  assert(pthread_getcpuclockid(pthread_self(), &clock) == 0);
+  assert(clock == CLOCK_THREAD_CPUTIME_ID);
+#else
+  assert(pthread_getcpuclockid(pthread_self(), &clock) == ENOTSUP);
+#endif
+
+  assert(sem_init(&done, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+  assert(pthread_create(&spinThread, NULL, spinner, NULL) == 0);
+  assert(pthread_create(&sleepThread, NULL, sleeper, NULL) == 0);
+
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  /* Only the calling thread has a clock ID. */
+  assert(pthread_getcpuclockid(spinThread, &clock) == ENOENT);
+#endif
+
+  pte_osThreadSleep(2 * RUN_MSECS);
+
+  assert(cpuMillisecs(spinThread) >= RUN_MSECS / 2);
+  assert(cpuMillisecs(sleepThread) < RUN_MSECS / 2);
+
+  assert(sem_post(&done) == 0);
+  assert(sem_post(&done) == 0);
+  assert(pthread_join(spinThread, NULL) == 0);
+  assert(pthread_join(sleepThread, NULL) == 0);
+  assert(sem_destroy(&done) == 0);
+
+  return 0;
+}
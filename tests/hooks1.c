@@ -0,0 +1,177 @@
+/*
+ * hooks1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test instrumentation hooks: a thread that blocks on a mutex and a
+ * semaphore must produce matching before_block/after_wake calls, a
+ * lock_acquired for the mutex (and lock_released from its holder),
+ * and thread_start/thread_exit on itself. Passes trivially when the
+ * library was built without PTE_HOOKS.
+ *
+ * Depends on API functions:
+ *	pthread_sethooks_np()
+ *	pthread_create()
+ *	pthread_join()
+ *	pthread_mutex_lock()
+ *	pthread_mutex_unlock()
+ *	sem_wait()
+ *	sem_post()
+ */
+
+#include "test.h"
+
+static pthread_mutex_t mx = PTHREAD_MUTEX_INITIALIZER;
+static sem_t s;
+static pthread_t worker;
+
+static int blocked[PTHREAD_HOOK_JOIN_NP + 1];
+static int woken[PTHREAD_HOOK_JOIN_NP + 1];
+static int acquired;
+static int released;
+static int started;
+static int exited;
+
+static void
+before_block(int kind, void * object)
+{
+  assert(kind >= PTHREAD_HOOK_MUTEX_NP && kind <= PTHREAD_HOOK_JOIN_NP);
+  assert(object != NULL);
+  pte_osAtomicIncrement(&blocked[kind]);
+}
+
+static void
+after_wake(int kind, void * object)
+{
+  assert(kind >= PTHREAD_HOOK_MUTEX_NP && kind <= PTHREAD_HOOK_JOIN_NP);
+  assert(object != NULL);
+  pte_osAtomicIncrement(&woken[kind]);
+}
+
+static void
+lock_acquired(void * mutex)
+{
+  if (mutex == (void *) mx)
+    {
+      pte_osAtomicIncrement(&acquired);
+    }
+}
+
+static void
+lock_released(void * mutex)
+{
+  if (mutex == (void *) mx)
+    {
+      pte_osAtomicIncrement(&released);
+    }
+}
+
+static void
+thread_start(pthread_t thread)
+{
+  if (pthread_equal(thread, pthread_self()))
+    {
+      pte_osAtomicIncrement(&started);
+    }
+}
+
+static void
+thread_exit(pthread_t thread)
+{
+  if (pthread_equal(thread, pthread_self()))
+    {
+      pte_osAtomicIncrement(&exited);
+    }
+}
+
+static void *
+func(void * arg)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  assert(sem_wait(&s) == 0);
+
+  return arg;
+}
+
+int pthread_test_hooks1()
+{
+  pthread_hooks_np_t hooks;
+  int kind;
+
+  mx = PTHREAD_MUTEX_INITIALIZER;
+
+  hooks.before_block = before_block;
+  hooks.after_wake = after_wake;
+  hooks.lock_acquired = lock_acquired;
+  hooks.lock_released = lock_released;
+  hooks.thread_start = thread_start;
+  hooks.thread_exit = thread_exit;
+
+  if (pthread_sethooks_np(&hooks) == ENOSYS)
+    {
+      assert(pthread_sethooks_np(NULL) == ENOSYS);
+      return 0;
+    }
+
+  assert(sem_init(&s, 0, 0) == 0);
+
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_create(&worker, NULL, func, NULL) == 0);
+
+  /* Let the worker block on the mutex, then on the semaphore. */
+  pte_osThreadSleep(200);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  pte_osThreadSleep(200);
+  assert(sem_post(&s) == 0);
+
+  assert(pthread_join(worker, NULL) == 0);
+
+  assert(pthread_sethooks_np(NULL) == 0);
+
+  assert(blocked[PTHREAD_HOOK_MUTEX_NP] == 1);
+  assert(blocked[PTHREAD_HOOK_SEM_NP] == 1);
+  for (kind = PTHREAD_HOOK_MUTEX_NP; kind <= PTHREAD_HOOK_JOIN_NP; kind++)
+    {
+      assert(woken[kind] == blocked[kind]);
+    }
+  assert(acquired == 1);
+  /* The worker's own unlock can also see the waiter flag it set. */
+  assert(released >= 1);
+  assert(started == 1);
+  assert(exited == 1);
+
+  /* Removed hooks are no longer called. */
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(acquired == 1);
+
+  assert(sem_destroy(&s) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+
+  return 0;
+}
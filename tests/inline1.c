@@ -0,0 +1,123 @@
+/*
+ * inline1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test the inline fast paths enabled by PTHREAD_INLINE_FAST_PATHS_NP:
+ * statically initialised, contended, non-NORMAL and misused mutexes
+ * and spinlocks must behave exactly as through the library calls.
+ *
+ * Depends on API functions:
+ *	pthread_mutex_lock()
+ *	pthread_mutex_trylock()
+ *	pthread_mutex_unlock()
+ *	pthread_spin_lock()
+ *	pthread_spin_trylock()
+ *	pthread_spin_unlock()
+ *	pthread_create()
+ *	pthread_join()
+ */
+
+#define PTHREAD_INLINE_FAST_PATHS_NP
+#include "test.h"
+
+#ifndef pthread_mutex_lock
+#error PTHREAD_INLINE_FAST_PATHS_NP did not enable the inline fast paths
+#endif
+
+static pthread_mutex_t mx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t rmx = PTHREAD_RECURSIVE_MUTEX_INITIALIZER;
+static pthread_spinlock_t spl = PTHREAD_SPINLOCK_INITIALIZER;
+static int counter;
+
+static void *
+func(void * arg)
+{
+  int i;
+
+  for (i = 0; i < 10000; i++)
+    {
+      assert(pthread_mutex_lock(&mx) == 0);
+      counter++;
+      assert(pthread_mutex_unlock(&mx) == 0);
+
+      assert(pthread_spin_lock(&spl) == 0);
+      counter++;
+      assert(pthread_spin_unlock(&spl) == 0);
+    }
+
+  return arg;
+}
+
+int pthread_test_inline1()
+{
+  pthread_t t[4];
+  int i;
+
+  mx = PTHREAD_MUTEX_INITIALIZER;
+  rmx = PTHREAD_RECURSIVE_MUTEX_INITIALIZER;
+  spl = PTHREAD_SPINLOCK_INITIALIZER;
+
+  /* First use goes through the library to initialise the mutex. */
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_trylock(&mx) == EBUSY);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == EPERM);
+
+  /* Recursive mutexes always take the library path. */
+  assert(pthread_mutex_lock(&rmx) == 0);
+  assert(pthread_mutex_lock(&rmx) == 0);
+  assert(pthread_mutex_unlock(&rmx) == 0);
+  assert(pthread_mutex_unlock(&rmx) == 0);
+  assert(pthread_mutex_unlock(&rmx) == EPERM);
+
+  assert(pthread_spin_unlock(&spl) == EPERM);
+  assert(pthread_spin_lock(&spl) == 0);
+  assert(pthread_spin_trylock(&spl) == EBUSY);
+  assert(pthread_spin_unlock(&spl) == 0);
+  assert(pthread_spin_unlock(&spl) == EPERM);
+
+  /* Contention hands over to the library and back. */
+  counter = 0;
+  for (i = 0; i < 4; i++)
+    {
+      assert(pthread_create(&t[i], NULL, func, NULL) == 0);
+    }
+  for (i = 0; i < 4; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+  assert(counter == 4 * 2 * 10000);
+
+  assert(pthread_mutex_trylock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(pthread_mutex_destroy(&rmx) == 0);
+  assert(pthread_spin_destroy(&spl) == 0);
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * mutex10.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test the PTHREAD_MUTEX_NORMAL entry points:
+ * - a statically initialised mutex is initialised on first use;
+ * - lock, trylock and unlock report EBUSY and EPERM like the
+ *   generic calls;
+ * - under contention they exclude each other and the generic
+ *   calls on the same mutex.
+ *
+ * Depends on API functions:
+ *	pthread_create()
+ *	pthread_join()
+ *	pthread_mutex_init()
+ *	pthread_mutex_lock()
+ *	pthread_mutex_unlock()
+ *	pthread_mutex_lock_normal_np()
+ *	pthread_mutex_trylock_normal_np()
+ *	pthread_mutex_unlock_normal_np()
+ */
+
+#include "test.h"
+
+#define ITERATIONS 10000
+
+static pthread_mutex_t smx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t mx;
+
+static int washer = 0;
+
+static void *
+typed(void * arg)
+{
+  int i;
+
+  for (i = 0; i < ITERATIONS; i++)
+    {
+      assert(pthread_mutex_lock_normal_np(&mx) == 0);
+      washer++;
+      assert(pthread_mutex_unlock_normal_np(&mx) == 0);
+    }
+
+  return arg;
+}
+
+static void *
+generic(void * arg)
+{
+  int i;
+
+  for (i = 0; i < ITERATIONS; i++)
+    {
+      assert(pthread_mutex_lock(&mx) == 0);
+      washer++;
+      assert(pthread_mutex_unlock(&mx) == 0);
+    }
+
+  return arg;
+}
+
+int pthread_test_mutex10()
+{
+  pthread_mutexattr_t ma;
+  pthread_t t[4];
+  int i;
+
+  smx = PTHREAD_MUTEX_INITIALIZER;
+  washer = 0;
+
+  assert(pthread_mutex_trylock_normal_np(&smx) == 0);
+  assert(smx != PTHREAD_MUTEX_INITIALIZER);
+  assert(pthread_mutex_trylock_normal_np(&smx) == EBUSY);
+  assert(pthread_mutex_unlock_normal_np(&smx) == 0);
+  assert(pthread_mutex_unlock_normal_np(&smx) == EPERM);
+  assert(pthread_mutex_lock_normal_np(&smx) == 0);
+  assert(pthread_mutex_unlock(&smx) == 0);
+  assert(pthread_mutex_destroy(&smx) == 0);
+
+  assert(pthread_mutexattr_init(&ma) == 0);
+  assert(pthread_mutexattr_settype(&ma, PTHREAD_MUTEX_NORMAL) == 0);
+  assert(pthread_mutex_init(&mx, &ma) == 0);
+
+  for (i = 0; i < 4; i++)
+    {
+      assert(pthread_create(&t[i], NULL, (i & 1) ? generic : typed, NULL) == 0);
+    }
+  for (i = 0; i < 4; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+  assert(washer == 4 * ITERATIONS);
+
+  assert(pthread_mutex_trylock(&mx) == 0);
+  assert(pthread_mutex_unlock_normal_np(&mx) == 0);
+
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+
+  return 0;
+}
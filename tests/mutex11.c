@@ -0,0 +1,164 @@
+/*
+ * mutex11.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test pthread_mutex_reltimedlock_np().
+ *
+ * Test Method (Validation or Falsification):
+ * - Validation
+ *
+ * Requirements Tested:
+ * - A held mutex is waited for at least the interval, and the
+ *   lock is taken if it is released in time.
+ *
+ * Features Tested:
+ * - Relative timeouts on each mutex kind.
+ *
+ * Cases Tested:
+ * - Invalid interval.
+ * - Unlocked mutex with a zero interval.
+ * - Timeout while another thread holds the mutex.
+ * - Release during the wait.
+ * - Relock by the owner.
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * - The OS timer has a granularity of well under 50 milliseconds.
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+enum
+{
+  WAIT_MSECS = 100
+};
+
+static pthread_mutex_t mutex;
+static sem_t held;
+static sem_t release;
+
+static void *
+holder(void * arg)
+{
+  assert(pthread_mutex_lock(&mutex) == 0);
+  assert(sem_post(&held) == 0);
+  assert(sem_wait(&release) == 0);
+  pte_osThreadSleep(WAIT_MSECS);
+  assert(pthread_mutex_unlock(&mutex) == 0);
+
+  return 0;
+}
+
+int pthread_test_mutex11()
+{
+  static const int kinds[] =
+    {
+      PTHREAD_MUTEX_NORMAL,
+      PTHREAD_MUTEX_ERRORCHECK,
+      PTHREAD_MUTEX_RECURSIVE
+    };
+  pthread_mutexattr_t ma;
+  pthread_t t;
+  struct timespec reltime;
+  unsigned long long start;
+  unsigned long long waited;
+  int i;
+
+  assert(sem_init(&held, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+  assert(sem_init(&release, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+  assert(pthread_mutexattr_init(&ma) == 0);
+
+  for (i = 0; i < (int) (sizeof(kinds) / sizeof(kinds[0])); i++)
+    {
+      assert(pthread_mutexattr_settype(&ma, kinds[i]) == 0);
+      assert(pthread_mutex_init(&mutex, &ma) == 0);
+
+      reltime.tv_sec = 0;
+      reltime.tv_nsec = -1;
+      assert(pthread_mutex_reltimedlock_np(&mutex, &reltime) == EINVAL);
+
+      reltime.tv_nsec = 0;
+      assert(pthread_mutex_reltimedlock_np(&mutex, &reltime) == 0);
+
+      if (kinds[i] == PTHREAD_MUTEX_RECURSIVE)
+        {
+          assert(pthread_mutex_reltimedlock_np(&mutex, &reltime) == 0);
+          assert(pthread_mutex_unlock(&mutex) == 0);
+        }
+      else if (kinds[i] == PTHREAD_MUTEX_ERRORCHECK)
+        {
+          assert(pthread_mutex_reltimedlock_np(&mutex, &reltime) == EDEADLK);
+        }
+
+      assert(pthread_mutex_unlock(&mutex) == 0);
+
+      assert(pthread_create(&t, NULL, holder, NULL) == 0);
+      assert(sem_wait(&held) == 0);
+
+      /* Held throughout: wait the full interval. */
+      reltime.tv_nsec = WAIT_MSECS * 1000000;
+      start = pte_osClockGetNanoseconds();
+      assert(pthread_mutex_reltimedlock_np(&mutex, &reltime) == ETIMEDOUT);
+      waited = (pte_osClockGetNanoseconds() - start) / 1000000;
+      assert(waited >= WAIT_MSECS - 1);
+
+      /* Released part way through a long wait. */
+      reltime.tv_sec = 10;
+      reltime.tv_nsec = 0;
+      assert(sem_post(&release) == 0);
+      assert(pthread_mutex_reltimedlock_np(&mutex, &reltime) == 0);
+      assert(pthread_mutex_unlock(&mutex) == 0);
+
+      assert(pthread_join(t, NULL) == 0);
+      assert(pthread_mutex_destroy(&mutex) == 0);
+    }
+
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+  assert(sem_destroy(&held) == 0);
+  assert(sem_destroy(&release) == 0);
+
+  return 0;
+}
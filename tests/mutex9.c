@@ -0,0 +1,142 @@
+/*
+ * mutex9.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test pthread_mutex_lock_many_np() and pthread_mutex_unlock_many_np().
+ * - all mutexes in the set are held after a successful lock,
+ *   including statically initialised and duplicated entries.
+ * - two threads locking the same set in opposite orders
+ *   make progress without deadlocking.
+ *
+ * Depends on API functions:
+ *	pthread_create()
+ *	pthread_join()
+ *	pthread_mutex_init()
+ *	pthread_mutex_trylock()
+ *	pthread_mutex_lock_many_np()
+ *	pthread_mutex_unlock_many_np()
+ */
+
+#include "test.h"
+
+#define ITERATIONS 10000
+
+static pthread_mutex_t mxA;
+static pthread_mutex_t mxB;
+static pthread_mutex_t mxC = PTHREAD_MUTEX_INITIALIZER;
+
+static int washer = 0;
+
+static void *
+forward(void * arg)
+{
+  pthread_mutex_t * set[3] = { &mxA, &mxB, &mxC };
+  int i;
+
+  for (i = 0; i < ITERATIONS; i++)
+    {
+      assert(pthread_mutex_lock_many_np(set, 3) == 0);
+      washer++;
+      assert(pthread_mutex_unlock_many_np(set, 3) == 0);
+    }
+
+  return 0;
+}
+
+static void *
+backward(void * arg)
+{
+  pthread_mutex_t * set[3] = { &mxC, &mxB, &mxA };
+  int i;
+
+  for (i = 0; i < ITERATIONS; i++)
+    {
+      assert(pthread_mutex_lock_many_np(set, 3) == 0);
+      washer++;
+      assert(pthread_mutex_unlock_many_np(set, 3) == 0);
+    }
+
+  return 0;
+}
+
+static void *
+trylocker(void * arg)
+{
+  pthread_mutex_t * mx = (pthread_mutex_t *) arg;
+
+  return (void *) (size_t) pthread_mutex_trylock(mx);
+}
+
+int
+pthread_test_mutex9()
+{
+  pthread_t t[2];
+  pthread_mutex_t * set[4];
+  void * result;
+
+  washer = 0;
+  mxC = PTHREAD_MUTEX_INITIALIZER;
+
+  assert(pthread_mutex_init(&mxA, NULL) == 0);
+  assert(pthread_mutex_init(&mxB, NULL) == 0);
+
+  assert(pthread_mutex_lock_many_np(NULL, 1) == EINVAL);
+  assert(pthread_mutex_lock_many_np(set, 0) == EINVAL);
+
+  set[0] = &mxB;
+  set[1] = &mxC;
+  set[2] = &mxA;
+  set[3] = &mxB;
+
+  assert(pthread_mutex_lock_many_np(set, 4) == 0);
+  assert(mxC != PTHREAD_MUTEX_INITIALIZER);
+
+  assert(pthread_create(&t[0], NULL, trylocker, (void *) &mxA) == 0);
+  assert(pthread_join(t[0], &result) == 0);
+  assert((int) (size_t) result == EBUSY);
+  assert(pthread_create(&t[0], NULL, trylocker, (void *) &mxC) == 0);
+  assert(pthread_join(t[0], &result) == 0);
+  assert((int) (size_t) result == EBUSY);
+
+  assert(pthread_mutex_unlock_many_np(set, 4) == 0);
+
+  assert(pthread_mutex_trylock(&mxB) == 0);
+  assert(pthread_mutex_unlock(&mxB) == 0);
+
+  assert(pthread_create(&t[0], NULL, forward, NULL) == 0);
+  assert(pthread_create(&t[1], NULL, backward, NULL) == 0);
+  assert(pthread_join(t[0], NULL) == 0);
+  assert(pthread_join(t[1], NULL) == 0);
+
+  assert(washer == 2 * ITERATIONS);
+
+  assert(pthread_mutex_destroy(&mxA) == 0);
+  assert(pthread_mutex_destroy(&mxB) == 0);
+  assert(pthread_mutex_destroy(&mxC) == 0);
+
+  return 0;
+}
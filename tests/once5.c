@@ -0,0 +1,155 @@
+/*
+ * once5.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Run an init_routine that fails through pthread_once_result_np()
+ * from several threads, and check it runs once and every caller gets
+ * its error. Then hang an init_routine and check that another
+ * thread's pthread_once_timed_np() gives up at its deadline.
+ *
+ * Depends on API functions:
+ *	pthread_once_result_np()
+ *	pthread_once_timed_np()
+ *	pthread_once()
+ *	pthread_create()
+ *	sem_wait()
+ *	sem_post()
+ */
+
+#include "test.h"
+
+enum
+{
+  NUMTHREADS = 4,
+  WAIT_MSECS = 100
+};
+
+static pthread_once_t failOnce = PTHREAD_ONCE_INIT;
+static pthread_once_t hangOnce = PTHREAD_ONCE_INIT;
+static int failCalls;
+static int hangCalls;
+static sem_t started;
+static sem_t release;
+
+static int
+failInit(void)
+{
+  failCalls++;
+  pte_osThreadSleep(10);
+
+  return EAGAIN;
+}
+
+static void *
+failFunc(void * arg)
+{
+  assert(pthread_once_result_np(&failOnce, failInit, NULL) == EAGAIN);
+
+  return 0;
+}
+
+static void
+hangInit(void)
+{
+  hangCalls++;
+  assert(sem_post(&started) == 0);
+  assert(sem_wait(&release) == 0);
+}
+
+static void *
+hangFunc(void * arg)
+{
+  assert(pthread_once_timed_np(&hangOnce, hangInit, NULL) == 0);
+
+  return 0;
+}
+
+int pthread_test_once5()
+{
+  const long long NANOSEC_PER_MILLISEC = 1000000;
+  pthread_t t[NUMTHREADS];
+  struct timespec abstime;
+  struct _timeb currSysTime;
+  unsigned long long start;
+  int i;
+
+  failOnce = (pthread_once_t) PTHREAD_ONCE_INIT;
+  hangOnce = (pthread_once_t) PTHREAD_ONCE_INIT;
+  failCalls = 0;
+  hangCalls = 0;
+
+  assert(pthread_once_result_np(NULL, failInit, NULL) == EINVAL);
+  assert(pthread_once_timed_np(&hangOnce, NULL, NULL) == EINVAL);
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, failFunc, NULL) == 0);
+    }
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(failCalls == 1);
+  assert(pthread_once_result_np(&failOnce, failInit, NULL) == EAGAIN);
+  assert(failCalls == 1);
+
+  assert(sem_init(&started, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+  assert(sem_init(&release, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+
+  assert(pthread_create(&t[0], NULL, hangFunc, NULL) == 0);
+  assert(sem_wait(&started) == 0);
+
+  _ftime(&currSysTime);
+
+  abstime.tv_sec = currSysTime.time;
+  abstime.tv_nsec = NANOSEC_PER_MILLISEC * currSysTime.millitm;
+  abstime.tv_nsec += NANOSEC_PER_MILLISEC * WAIT_MSECS;
+
+  if (abstime.tv_nsec >= NANOSEC_PER_MILLISEC * 1000)
+    {
+      abstime.tv_sec += 1;
+      abstime.tv_nsec -= NANOSEC_PER_MILLISEC * 1000;
+    }
+
+  start = pte_osClockGetNanoseconds();
+  assert(pthread_once_timed_np(&hangOnce, hangInit, &abstime) == ETIMEDOUT);
+  assert((pte_osClockGetNanoseconds() - start) / NANOSEC_PER_MILLISEC >= WAIT_MSECS - 10);
+
+  assert(sem_post(&release) == 0);
+  assert(pthread_join(t[0], NULL) == 0);
+
+  assert(pthread_once_timed_np(&hangOnce, hangInit, &abstime) == 0);
+  assert(pthread_once(&hangOnce, hangInit) == 0);
+  assert(hangCalls == 1);
+
+  assert(sem_destroy(&started) == 0);
+  assert(sem_destroy(&release) == 0);
+
+  return 0;
+}
@@ -0,0 +1,231 @@
+/*
+ * priority3.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test that mutexes, semaphores and condition variables created
+ *   with priority wake order release their highest priority waiter
+ *   first.
+ *
+ * Description:
+ * - Waiters are started lowest priority first, so that FIFO order
+ *   would release them in the opposite order to the one expected.
+ *   Once all are blocked the object is released once; every waiter
+ *   records its priority when it gets through and releases the next.
+ *   The time from the first release to the first waiter getting
+ *   through is also checked, to catch wakeups lost in the reordering.
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+enum
+{
+  NUMTHREADS = 4
+};
+
+static pthread_mutex_t mx;
+static pthread_cond_t cv;
+static sem_t s;
+static int tokens;
+
+static int order[NUMTHREADS];
+static int numWoken;
+static unsigned long long releaseNs;
+static unsigned long long firstWakeNs;
+
+static void
+record(void)
+{
+  struct sched_param param;
+  int policy;
+
+  assert(pthread_getschedparam(pthread_self(), &policy, &param) == 0);
+
+  if (numWoken == 0)
+    {
+      firstWakeNs = pte_osClockGetNanoseconds();
+    }
+
+  order[numWoken++] = param.sched_priority;
+}
+
+static void *
+mutexWaiter(void * arg)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  record();
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  return NULL;
+}
+
+static void *
+semWaiter(void * arg)
+{
+  assert(sem_wait(&s) == 0);
+  record();
+  assert(sem_post(&s) == 0);
+
+  return NULL;
+}
+
+static void *
+condWaiter(void * arg)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+
+  while (tokens == 0)
+    {
+      assert(pthread_cond_wait(&cv, &mx) == 0);
+    }
+
+  tokens--;
+  record();
+
+  /* Pass the wakeup on. */
+  tokens++;
+  assert(pthread_cond_signal(&cv) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  return NULL;
+}
+
+/*
+ * Start the waiters lowest priority first, call 'release' once they
+ * have all blocked, and check they got through highest priority first.
+ */
+static void
+runWaiters(void * (*waiter)(void *), void (*release)(void))
+{
+  pthread_t t[NUMTHREADS];
+  pthread_attr_t attr;
+  struct sched_param param;
+  int i;
+
+  numWoken = 0;
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED) == 0);
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      param.sched_priority = sched_get_priority_min(SCHED_OTHER) + 1 + i;
+      assert(pthread_attr_setschedparam(&attr, &param) == 0);
+      assert(pthread_create(&t[i], &attr, waiter, NULL) == 0);
+
+      /* Let it block before the next one is started. */
+      pte_osThreadSleep(50);
+    }
+
+  releaseNs = pte_osClockGetNanoseconds();
+  release();
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  assert(numWoken == NUMTHREADS);
+
+  for (i = 1; i < NUMTHREADS; i++)
+    {
+      assert(order[i - 1] > order[i]);
+    }
+
+  assert(firstWakeNs - releaseNs < 1000000000ULL);
+}
+
+static void
+releaseMutex(void)
+{
+  assert(pthread_mutex_unlock(&mx) == 0);
+}
+
+static void
+releaseSem(void)
+{
+  assert(sem_post(&s) == 0);
+}
+
+static void
+releaseCond(void)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  tokens = 1;
+  assert(pthread_cond_signal(&cv) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+}
+
+int pthread_test_priority3()
+{
+  pthread_mutexattr_t ma;
+  pthread_condattr_t ca;
+  int order;
+
+  assert(pthread_mutexattr_init(&ma) == 0);
+  assert(pthread_mutexattr_getwakeorder_np(&ma, &order) == 0);
+  assert(order == PTHREAD_WAKE_DEFAULT_NP);
+  assert(pthread_mutexattr_setwakeorder_np(&ma, 2) == EINVAL);
+  assert(pthread_mutexattr_setwakeorder_np(&ma, PTHREAD_WAKE_PRIORITY_NP) == 0);
+  assert(pthread_mutexattr_getwakeorder_np(&ma, &order) == 0);
+  assert(order == PTHREAD_WAKE_PRIORITY_NP);
+
+  if (pthread_mutex_init(&mx, &ma) == ENOTSUP)
+    {
+      /* The OS cannot order its waiters by priority. */
+      assert(pthread_mutexattr_destroy(&ma) == 0);
+      return 0;
+    }
+
+  assert(pthread_mutex_lock(&mx) == 0);
+  runWaiters(mutexWaiter, releaseMutex);
+
+  assert(sem_init_np(&s, 0, 0, SEM_WAKE_PRIORITY_NP) == 0);
+  runWaiters(semWaiter, releaseSem);
+  assert(sem_destroy(&s) == 0);
+
+  assert(pthread_condattr_init(&ca) == 0);
+  assert(pthread_condattr_setwakeorder_np(&ca, PTHREAD_WAKE_PRIORITY_NP) == 0);
+  assert(pthread_cond_init(&cv, &ca) == 0);
+  tokens = 0;
+  runWaiters(condWaiter, releaseCond);
+  assert(pthread_cond_destroy(&cv) == 0);
+  assert(pthread_condattr_destroy(&ca) == 0);
+
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+
+  return 0;
+}
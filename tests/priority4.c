@@ -0,0 +1,204 @@
+/*
+ * priority4.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test the SCHED_FIFO and SCHED_RR policies.
+ *
+ * Test Method (Validation or Falsification):
+ * - Validation
+ *
+ * Requirements Tested:
+ * - pthread_attr_setschedpolicy, pthread_setschedparam and
+ *   sched_setscheduler accept SCHED_FIFO and SCHED_RR, and
+ *   pthread_getschedparam reports the policy in effect.
+ *
+ * Features Tested:
+ * - Real-time priority band.
+ * - sched_rr_get_interval.
+ *
+ * Cases Tested:
+ * - Threads created with each real-time policy, inside and below
+ *   the band.
+ * - Changing the policy of a running thread both ways.
+ * - Invalid policies and pids.
+ *
+ * Description:
+ * - The real-time policies share the band above the default priority,
+ *   so a priority that is valid for SCHED_OTHER may be rejected for
+ *   them. sched_rr_get_interval may only fail with ENOTSUP, and only
+ *   once a SCHED_RR thread has shown the OS cannot time slice.
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * -
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+static int expectedPolicy;
+static int expectedPrio;
+
+static void *
+func(void * arg)
+{
+  int policy;
+  struct sched_param param;
+
+  assert(pthread_getschedparam(pthread_self(), &policy, &param) == 0);
+  assert(policy == expectedPolicy);
+  assert(param.sched_priority == expectedPrio);
+
+  assert(pte_osThreadGetPriority(pte_osThreadGetHandle()) == param.sched_priority);
+
+  return (void *) 0;
+}
+
+int pthread_test_priority4()
+{
+  pthread_t t;
+  pthread_attr_t attr;
+  struct sched_param param;
+  struct sched_param saved;
+  struct timespec interval;
+  int savedPolicy;
+  int policy;
+  int rtMin;
+  int rtMax;
+  int r;
+
+  rtMin = sched_get_priority_min(SCHED_FIFO);
+  rtMax = sched_get_priority_max(SCHED_FIFO);
+
+  assert(rtMin == sched_get_priority_min(SCHED_RR));
+  assert(rtMax == sched_get_priority_max(SCHED_RR));
+  assert(rtMin >= sched_get_priority_min(SCHED_OTHER));
+  assert(rtMax == sched_get_priority_max(SCHED_OTHER));
+  assert(rtMin <= rtMax);
+
+  errno = 0;
+  assert(sched_get_priority_min(SCHED_MAX + 1) == -1);
+  assert(errno == EINVAL);
+  errno = 0;
+  assert(sched_get_priority_max(SCHED_MAX + 1) == -1);
+  assert(errno == EINVAL);
+
+  assert(pthread_attr_init(&attr) == 0);
+  assert(pthread_attr_getschedpolicy(&attr, &policy) == 0);
+  assert(policy == SCHED_OTHER);
+  assert(pthread_attr_setschedpolicy(&attr, SCHED_MAX + 1) == EINVAL);
+  assert(pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED) == 0);
+
+  /* A thread of each real-time policy, at the bottom of the band. */
+  for (policy = SCHED_FIFO; policy <= SCHED_RR; policy++)
+    {
+      int got;
+
+      assert(pthread_attr_setschedpolicy(&attr, policy) == 0);
+      assert(pthread_attr_getschedpolicy(&attr, &got) == 0);
+      assert(got == policy);
+
+      param.sched_priority = rtMin;
+      assert(pthread_attr_setschedparam(&attr, &param) == 0);
+
+      expectedPolicy = policy;
+      expectedPrio = rtMin;
+      assert(pthread_create(&t, &attr, func, NULL) == 0);
+      assert(pthread_join(t, NULL) == 0);
+
+      /* Below the band is valid for SCHED_OTHER only. */
+      if (rtMin > sched_get_priority_min(SCHED_OTHER))
+        {
+          param.sched_priority = rtMin - 1;
+          assert(pthread_attr_setschedparam(&attr, &param) == 0);
+          assert(pthread_create(&t, &attr, func, NULL) == EINVAL);
+        }
+    }
+
+  assert(pthread_attr_destroy(&attr) == 0);
+
+  /* A SCHED_RR thread exists now, so the answer is final. */
+  r = sched_rr_get_interval(0, &interval);
+  assert(r == 0 || errno == ENOTSUP);
+  if (r == 0)
+    {
+      assert(interval.tv_sec > 0 || interval.tv_nsec > 0);
+    }
+
+  errno = 0;
+  assert(sched_rr_get_interval(1, &interval) == -1);
+  assert(errno == ESRCH);
+
+  /* Change our own policy and back again. */
+  assert(pthread_getschedparam(pthread_self(), &savedPolicy, &saved) == 0);
+
+  param.sched_priority = rtMax;
+  assert(pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0);
+  assert(pthread_getschedparam(pthread_self(), &policy, &param) == 0);
+  assert(policy == SCHED_RR);
+  assert(param.sched_priority == rtMax);
+
+  assert(sched_setscheduler(0, SCHED_FIFO) == SCHED_RR);
+  assert(pthread_getschedparam(pthread_self(), &policy, &param) == 0);
+  assert(policy == SCHED_FIFO);
+  assert(param.sched_priority == rtMax);
+
+  errno = 0;
+  assert(sched_setscheduler(1, SCHED_OTHER) == -1);
+  assert(errno == ESRCH);
+  errno = 0;
+  assert(sched_setscheduler(0, SCHED_MAX + 1) == -1);
+  assert(errno == EINVAL);
+
+  if (rtMin > sched_get_priority_min(SCHED_OTHER))
+    {
+      param.sched_priority = rtMin - 1;
+      assert(pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == EINVAL);
+    }
+
+  assert(pthread_setschedparam(pthread_self(), savedPolicy, &saved) == 0);
+  assert(pthread_getschedparam(pthread_self(), &policy, &param) == 0);
+  assert(policy == savedPolicy);
+  assert(param.sched_priority == saved.sched_priority);
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * profile1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test contention sampling: contended mutex and rwlock locks are
+ * recorded against their call sites, ordered by total wait, and
+ * only every period'th contended lock on a thread is sampled.
+ *
+ * Depends on API functions:
+ *	pthread_profile_enable_np()
+ *	pthread_profile_top_np()
+ *	pthread_create()
+ *	pthread_join()
+ *	pthread_mutex_lock()
+ *	pthread_mutex_unlock()
+ *	pthread_rwlock_rdlock()
+ *	pthread_rwlock_wrlock()
+ *	pthread_rwlock_unlock()
+ *	sem_wait()
+ *	sem_post()
+ */
+
+#include "test.h"
+
+static pthread_mutex_t mx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_rwlock_t rwl = PTHREAD_RWLOCK_INITIALIZER;
+static sem_t go;
+static sem_t done;
+
+static void *
+sites(void * arg)
+{
+  assert(sem_wait(&go) == 0);
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(sem_post(&done) == 0);
+
+  assert(sem_wait(&go) == 0);
+  assert(pthread_rwlock_rdlock(&rwl) == 0);
+  assert(pthread_rwlock_unlock(&rwl) == 0);
+
+  return arg;
+}
+
+static void *
+repeat(void * arg)
+{
+  int i;
+
+  for (i = 0; i < 4; i++)
+    {
+      assert(sem_wait(&go) == 0);
+      assert(pthread_mutex_lock(&mx) == 0);
+      assert(pthread_mutex_unlock(&mx) == 0);
+      assert(sem_post(&done) == 0);
+    }
+
+  return arg;
+}
+
+/*
+ * Holds mx while the worker tries to take it.
+ */
+static void
+contend(int msecs)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(sem_post(&go) == 0);
+  pte_osThreadSleep(msecs);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(sem_wait(&done) == 0);
+}
+
+int pthread_test_profile1()
+{
+  pthread_profile_site_np_t top[8];
+  pthread_t t;
+  int count;
+  int dropped;
+
+  mx = PTHREAD_MUTEX_INITIALIZER;
+  rwl = PTHREAD_RWLOCK_INITIALIZER;
+
+  assert(pthread_profile_enable_np(-1) == EINVAL);
+  count = 8;
+  assert(pthread_profile_top_np(NULL, &count, NULL) == EINVAL);
+  assert(pthread_profile_top_np(top, NULL, NULL) == EINVAL);
+
+  assert(sem_init(&go, 0, 0) == 0);
+  assert(sem_init(&done, 0, 0) == 0);
+
+  assert(pthread_profile_enable_np(1) == 0);
+
+  assert(pthread_create(&t, NULL, sites, NULL) == 0);
+  contend(100);
+
+  assert(pthread_rwlock_wrlock(&rwl) == 0);
+  assert(sem_post(&go) == 0);
+  pte_osThreadSleep(300);
+  assert(pthread_rwlock_unlock(&rwl) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  count = 8;
+  assert(pthread_profile_top_np(top, &count, &dropped) == 0);
+  assert(count == 2);
+  assert(dropped == 0);
+  assert(top[0].site != top[1].site);
+  assert(top[0].samples == 1);
+  assert(top[1].samples == 1);
+  /* The rwlock wait was the longer one. */
+  assert(top[0].totalWaitUs >= top[1].totalWaitUs);
+  assert(top[0].totalWaitUs >= 200000);
+  assert(top[0].maxWaitUs == top[0].totalWaitUs);
+
+  count = 1;
+  assert(pthread_profile_top_np(top + 4, &count, NULL) == 0);
+  assert(count == 1);
+  assert(top[4].site == top[0].site);
+
+  /* Stopped: nothing more is recorded... */
+  assert(pthread_profile_enable_np(0) == 0);
+  assert(pthread_create(&t, NULL, repeat, NULL) == 0);
+  contend(20);
+  contend(20);
+  count = 8;
+  assert(pthread_profile_top_np(top, &count, NULL) == 0);
+  assert(count == 2);
+  assert(top[0].samples == 1 && top[1].samples == 1);
+
+  /* ...and restarting clears the table and samples every 2nd lock. */
+  assert(pthread_profile_enable_np(2) == 0);
+  contend(20);
+  contend(20);
+  assert(pthread_join(t, NULL) == 0);
+  count = 8;
+  assert(pthread_profile_top_np(top, &count, NULL) == 0);
+  assert(count == 1);
+  assert(top[0].samples == 1);
+
+  assert(pthread_profile_enable_np(0) == 0);
+
+  assert(sem_destroy(&go) == 0);
+  assert(sem_destroy(&done) == 0);
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(pthread_rwlock_destroy(&rwl) == 0);
+
+  return 0;
+}
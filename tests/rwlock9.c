@@ -0,0 +1,134 @@
+/*
+ * rwlock9.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Check that timed rwlock waits end within one clock tick of
+ * their deadline, whether the lock is held by a writer or by
+ * readers and whether a writer is already queued.
+ *
+ * Assumes the OS timer has a granularity of TICK_MSECS or better.
+ *
+ * Depends on API functions:
+ *	pthread_rwlock_timedrdlock()
+ *	pthread_rwlock_timedwrlock()
+ *	pthread_rwlock_rdlock()
+ *	pthread_rwlock_wrlock()
+ *	pthread_rwlock_unlock()
+ */
+
+#include "test.h"
+
+enum
+{
+  WAIT_MSECS = 100,
+  TICK_MSECS = 10,
+  ROUNDS = 3
+};
+
+static pthread_rwlock_t rwlock;
+
+static int timedWriter;
+static int overshoot;
+
+static long long
+nowMillisecs(void)
+{
+  struct _timeb currSysTime;
+
+  _ftime(&currSysTime);
+
+  return (long long) currSysTime.time * 1000 + currSysTime.millitm;
+}
+
+static void * timedfunc(void * arg)
+{
+  const long long NANOSEC_PER_MILLISEC = 1000000;
+  struct timespec abstime;
+  long long deadline;
+  int result;
+
+  deadline = nowMillisecs() + WAIT_MSECS;
+
+  abstime.tv_sec = (time_t) (deadline / 1000);
+  abstime.tv_nsec = (long) (deadline % 1000) * NANOSEC_PER_MILLISEC;
+
+  if (timedWriter)
+    {
+      result = pthread_rwlock_timedwrlock(&rwlock, &abstime);
+    }
+  else
+    {
+      result = pthread_rwlock_timedrdlock(&rwlock, &abstime);
+    }
+
+  overshoot = (int) (nowMillisecs() - deadline);
+
+  assert(result == ETIMEDOUT);
+
+  return 0;
+}
+
+static void * wrfunc(void * arg)
+{
+  assert(pthread_rwlock_wrlock(&rwlock) == 0);
+  assert(pthread_rwlock_unlock(&rwlock) == 0);
+
+  return 0;
+}
+
+static void
+timeout(int writer)
+{
+  pthread_t t;
+
+  timedWriter = writer;
+  overshoot = -1000;
+
+  assert(pthread_create(&t, NULL, timedfunc, NULL) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(overshoot >= -1);
+  assert(overshoot <= TICK_MSECS);
+}
+
+int pthread_test_rwlock9()
+{
+  pthread_t wrt;
+  int i;
+
+  assert(pthread_rwlock_init(&rwlock, NULL) == 0);
+
+  for (i = 0; i < ROUNDS; i++)
+    {
+      /* Held by a writer. */
+      assert(pthread_rwlock_wrlock(&rwlock) == 0);
+      timeout(PTE_FALSE);
+      timeout(PTE_TRUE);
+      assert(pthread_rwlock_unlock(&rwlock) == 0);
+
+      /* Held by a reader. */
+      assert(pthread_rwlock_rdlock(&rwlock) == 0);
+      timeout(PTE_TRUE);
+
+      /* Held by a reader, behind a queued writer. */
+      assert(pthread_create(&wrt, NULL, wrfunc, NULL) == 0);
+      pte_osThreadSleep(TICK_MSECS);
+      timeout(PTE_FALSE);
+      assert(pthread_rwlock_unlock(&rwlock) == 0);
+      assert(pthread_join(wrt, NULL) == 0);
+    }
+
+  assert(pthread_rwlock_destroy(&rwlock) == 0);
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * semaphore7.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test static semaphores declared with SEM_INITIALIZER_NP():
+ * - the initial value is reported before and after first use,
+ * - several threads racing on first use share one semaphore,
+ * - an unused static semaphore can be destroyed.
+ *
+ */
+
+#include "test.h"
+
+enum
+{
+  NUMTHREADS = 8
+};
+
+static sem_t s1 = SEM_INITIALIZER_NP(3);
+static sem_t s2 = SEM_INITIALIZER_NP(0);
+static sem_t s3 = SEM_INITIALIZER_NP(5);
+
+static void *
+poster(void * arg)
+{
+  assert(sem_post(&s2) == 0);
+
+  return NULL;
+}
+
+int pthread_test_semaphore7(void)
+{
+  int value = -1;
+  int i;
+  pthread_t t[NUMTHREADS];
+
+  s1 = SEM_INITIALIZER_NP(3);
+  s2 = SEM_INITIALIZER_NP(0);
+  s3 = SEM_INITIALIZER_NP(5);
+
+  assert(sem_getvalue(&s1, &value) == 0);
+  assert(value == 3);
+
+  assert(sem_trywait(&s1) == 0);
+  assert(sem_getvalue(&s1, &value) == 0);
+  assert(value == 2);
+  assert(sem_wait(&s1) == 0);
+  assert(sem_wait(&s1) == 0);
+  assert(sem_trywait(&s1) == -1);
+  assert(errno == EAGAIN);
+  assert(sem_destroy(&s1) == 0);
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_create(&t[i], NULL, poster, NULL) == 0);
+    }
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(sem_wait(&s2) == 0);
+    }
+
+  for (i = 0; i < NUMTHREADS; i++)
+    {
+      assert(pthread_join(t[i], NULL) == 0);
+    }
+
+  assert(sem_getvalue(&s2, &value) == 0);
+  assert(value == 0);
+  assert(sem_destroy(&s2) == 0);
+
+  assert(sem_destroy(&s3) == 0);
+  assert(sem_post(&s3) == -1);
+  assert(errno == EINVAL);
+
+  return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * semaphore8.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test sem_reltimedwait_np().
+ *
+ * Test Method (Validation or Falsification):
+ * - Validation
+ *
+ * Requirements Tested:
+ * - The wait lasts at least the interval when nothing is posted,
+ *   and ends early when something is.
+ *
+ * Features Tested:
+ * - Relative timeouts.
+ *
+ * Cases Tested:
+ * - Invalid intervals.
+ * - Zero interval.
+ * - Timeout, and a post during the wait.
+ *
+ * Description:
+ * -
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * - The OS timer has a granularity of well under 50 milliseconds.
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+enum
+{
+  WAIT_MSECS = 100,
+  SLACK_MSECS = 50
+};
+
+static sem_t s;
+
+static void *
+poster(void * arg)
+{
+  pte_osThreadSleep(WAIT_MSECS);
+  assert(sem_post(&s) == 0);
+
+  return 0;
+}
+
+int pthread_test_semaphore8()
+{
+  pthread_t t;
+  struct timespec reltime;
+  unsigned long long start;
+  unsigned long long waited;
+  int value;
+
+  assert(sem_init(&s, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+
+  errno = 0;
+  assert(sem_reltimedwait_np(&s, NULL) == -1);
+  assert(errno == EINVAL);
+
+  reltime.tv_sec = 0;
+  reltime.tv_nsec = 1000000000;
+  errno = 0;
+  assert(sem_reltimedwait_np(&s, &reltime) == -1);
+  assert(errno == EINVAL);
+
+  reltime.tv_sec = -1;
+  reltime.tv_nsec = 0;
+  errno = 0;
+  assert(sem_reltimedwait_np(&s, &reltime) == -1);
+  assert(errno == EINVAL);
+
+  /* A zero interval polls. */
+  reltime.tv_sec = 0;
+  reltime.tv_nsec = 0;
+  errno = 0;
+  assert(sem_reltimedwait_np(&s, &reltime) == -1);
+  assert(errno == ETIMEDOUT);
+
+  assert(sem_post(&s) == 0);
+  assert(sem_reltimedwait_np(&s, &reltime) == 0);
+
+  /* Nothing posted: wait the full interval. */
+  reltime.tv_nsec = WAIT_MSECS * 1000000;
+  start = pte_osClockGetNanoseconds();
+  errno = 0;
+  assert(sem_reltimedwait_np(&s, &reltime) == -1);
+  assert(errno == ETIMEDOUT);
+  waited = (pte_osClockGetNanoseconds() - start) / 1000000;
+  assert(waited >= WAIT_MSECS - 1);
+
+  assert(sem_getvalue(&s, &value) == 0);
+  assert(value == 0);
+
+  /* Posted part way through a long wait. */
+  reltime.tv_sec = 10;
+  reltime.tv_nsec = 0;
+  assert(pthread_create(&t, NULL, poster, NULL) == 0);
+  start = pte_osClockGetNanoseconds();
+  assert(sem_reltimedwait_np(&s, &reltime) == 0);
+  waited = (pte_osClockGetNanoseconds() - start) / 1000000;
+  assert(waited < 10000 - SLACK_MSECS);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(sem_destroy(&s) == 0);
+
+  return 0;
+}
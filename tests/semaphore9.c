@@ -0,0 +1,136 @@
+/*
+ * semaphore9.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ * Test Synopsis:
+ * - Test that posts with no waiter do not leave the OS semaphore
+ *   ahead of the semaphore value.
+ *
+ * Test Method (Validation or Falsification):
+ * - Validation
+ *
+ * Requirements Tested:
+ * - A post is consumed by exactly one wait.
+ *
+ * Features Tested:
+ * - sem_post() when no thread is blocked.
+ *
+ * Cases Tested:
+ * - Post then wait, with no waiter at post time, followed by a
+ *   timed wait that must time out.
+ * - A blocked waiter still wakes on a later post.
+ *
+ * Description:
+ * - sem_post() used to release the OS semaphore on every post, so a
+ *   post that was consumed without blocking left a spare count
+ *   behind and the next blocking wait returned at once.
+ *
+ * Environment:
+ * -
+ *
+ * Input:
+ * - None.
+ *
+ * Output:
+ * - File name, Line number, and failed expression on failure.
+ * - No output on success.
+ *
+ * Assumptions:
+ * - The OS timer has a granularity of well under 50 milliseconds.
+ *
+ * Pass Criteria:
+ * - Process returns zero exit status.
+ *
+ * Fail Criteria:
+ * - Process returns non-zero exit status.
+ */
+
+#include "test.h"
+
+enum
+{
+  POSTS = 3,
+  WAIT_MSECS = 50
+};
+
+static sem_t s;
+
+static void *
+poster(void * arg)
+{
+  pte_osThreadSleep(WAIT_MSECS);
+  assert(sem_post(&s) == 0);
+
+  return 0;
+}
+
+int pthread_test_semaphore9()
+{
+  pthread_t t;
+  struct timespec reltime;
+  int value;
+  int i;
+
+  assert(sem_init(&s, PTHREAD_PROCESS_PRIVATE, 0) == 0);
+
+  /* Nobody is waiting for these, so none may reach the OS semaphore. */
+  for (i = 0; i < POSTS; i++)
+    {
+      assert(sem_post(&s) == 0);
+    }
+
+  for (i = 0; i < POSTS; i++)
+    {
+      assert(sem_wait(&s) == 0);
+    }
+
+  assert(sem_getvalue(&s, &value) == 0);
+  assert(value == 0);
+
+  /* Must block, and so time out, rather than take a spare OS count. */
+  reltime.tv_sec = 0;
+  reltime.tv_nsec = WAIT_MSECS * 1000000;
+  errno = 0;
+  assert(sem_reltimedwait_np(&s, &reltime) == -1);
+  assert(errno == ETIMEDOUT);
+
+  errno = 0;
+  assert(sem_trywait(&s) == -1);
+  assert(errno == EAGAIN);
+
+  /* A post to a blocked waiter still goes through the OS semaphore. */
+  assert(pthread_create(&t, NULL, poster, NULL) == 0);
+  assert(sem_wait(&s) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(sem_getvalue(&s, &value) == 0);
+  assert(value == 0);
+
+  assert(sem_destroy(&s) == 0);
+
+  return 0;
+}
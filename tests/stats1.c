@@ -0,0 +1,131 @@
+/*
+ * stats1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ *
+ * Test library statistics: check the counters move as objects are
+ * created, statically initialised objects are first used and thread
+ * structs go through the reuse queue, and that a reset only clears
+ * the totals. Passes trivially when the library was built without
+ * PTE_STATS.
+ *
+ * Depends on API functions:
+ *	pthread_getstats_np()
+ *	pthread_resetstats_np()
+ *	pthread_create()
+ *	pthread_join()
+ *	sem_init()
+ *	sem_destroy()
+ */
+
+#include "test.h"
+
+static pthread_mutex_t mx = PTHREAD_MUTEX_INITIALIZER;
+static pthread_rwlock_t rwl = PTHREAD_RWLOCK_INITIALIZER;
+static pthread_spinlock_t spl = PTHREAD_SPINLOCK_INITIALIZER;
+
+static void *
+func(void * arg)
+{
+  return arg;
+}
+
+int pthread_test_stats1()
+{
+  pthread_stats_np_t before;
+  pthread_stats_np_t after;
+  pthread_t t;
+  sem_t s;
+
+  mx = PTHREAD_MUTEX_INITIALIZER;
+  rwl = PTHREAD_RWLOCK_INITIALIZER;
+  spl = PTHREAD_SPINLOCK_INITIALIZER;
+
+  if (pthread_getstats_np(&before) == ENOSYS)
+    {
+      assert(pthread_resetstats_np() == ENOSYS);
+      return 0;
+    }
+
+  assert(pthread_getstats_np(NULL) == EINVAL);
+
+  assert(pthread_resetstats_np() == 0);
+  assert(pthread_getstats_np(&before) == 0);
+  assert(before.osSemaphoresCreated == 0);
+  assert(before.mutexLazyInits == 0);
+
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_rwlock_rdlock(&rwl) == 0);
+  assert(pthread_rwlock_unlock(&rwl) == 0);
+  assert(pthread_spin_lock(&spl) == 0);
+  assert(pthread_spin_unlock(&spl) == 0);
+
+  assert(pthread_getstats_np(&after) == 0);
+  assert(after.mutexLazyInits == 1);
+  assert(after.rwlockLazyInits == 1);
+  assert(after.spinLazyInits == 1);
+
+  assert(pthread_getstats_np(&before) == 0);
+  assert(sem_init(&s, 0, 0) == 0);
+  assert(pthread_getstats_np(&after) == 0);
+  /* The semaphore and its internal mutex each hold an OS semaphore. */
+  assert(after.osSemaphores == before.osSemaphores + 2);
+  assert(after.osSemaphoresCreated == before.osSemaphoresCreated + 2);
+  assert(sem_destroy(&s) == 0);
+  assert(pthread_getstats_np(&after) == 0);
+  assert(after.osSemaphores == before.osSemaphores);
+
+  /* A joined thread's struct goes onto the reuse queue... */
+  assert(pthread_create(&t, NULL, func, NULL) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(pthread_getstats_np(&before) == 0);
+  assert(before.osThreadsCreated == 1);
+  assert(before.reuseDepth >= 1);
+
+  /* ...and the next create takes it back off. */
+  assert(pthread_create(&t, NULL, func, NULL) == 0);
+  assert(pthread_join(t, NULL) == 0);
+  assert(pthread_getstats_np(&after) == 0);
+  assert(after.osThreadsCreated == 2);
+  assert(after.threadsReused == before.threadsReused + 1);
+  assert(after.reuseDepth == before.reuseDepth);
+
+  assert(pthread_resetstats_np() == 0);
+  assert(pthread_getstats_np(&after) == 0);
+  assert(after.osThreadsCreated == 0);
+  assert(after.threadsReused == 0);
+  assert(after.mutexLazyInits == 0);
+  assert(after.reuseDepth == before.reuseDepth);
+  assert(after.osTlsKeys == before.osTlsKeys);
+
+  assert(pthread_mutex_destroy(&mx) == 0);
+  assert(pthread_rwlock_destroy(&rwl) == 0);
+  assert(pthread_spin_destroy(&spl) == 0);
+
+  return 0;
+}
@@ -146,6 +146,11 @@ int pthread_test_mutex8e();
 int pthread_test_mutex8n();
 int pthread_test_mutex8r();
 
+int pthread_test_mutex9();
+
+int pthread_test_mutex10();
+int pthread_test_mutex11();
+
 int pthread_test_valid1();
 int pthread_test_valid2();
 
@@ -165,12 +170,16 @@ int pthread_test_semaphore4();
 int pthread_test_semaphore4t();
 int pthread_test_semaphore5();
 int pthread_test_semaphore6();
+int pthread_test_semaphore7();
+int pthread_test_semaphore8();
+int pthread_test_semaphore9();
 
 int pthread_test_barrier1();
 int pthread_test_barrier2();
 int pthread_test_barrier3();
 int pthread_test_barrier4();
 int pthread_test_barrier5();
+int pthread_test_barrier6();
 
 int pthread_test_count1();
 
@@ -195,6 +204,7 @@ int pthread_test_once1();
 int pthread_test_once2();
 int pthread_test_once3();
 int pthread_test_once4();
+int pthread_test_once5();
 
 int pthread_test_spin1();
 int pthread_test_spin2();
@@ -219,6 +229,7 @@ int pthread_test_condvar6();
 int pthread_test_condvar7();
 int pthread_test_condvar8();
 int pthread_test_condvar9();
+int pthread_test_condvar10();
 
 int pthread_test_stress1();
 
@@ -233,6 +244,20 @@ int pthread_test_exit5();
 int pthread_test_reuse1();
 int pthread_test_reuse2();
 
+int pthread_test_trace1();
+
+int pthread_test_stats1();
+
+int pthread_test_waits1();
+
+int pthread_test_hooks1();
+
+int pthread_test_profile1();
+
+int pthread_test_inline1();
+int pthread_test_cputime1();
+int pthread_test_concurrency1();
+
 int pthread_test_rwlock1();
 int pthread_test_rwlock2();
 int pthread_test_rwlock2t();
@@ -247,9 +272,12 @@ int pthread_test_rwlock6t();
 int pthread_test_rwlock6t2();
 int pthread_test_rwlock7();
 int pthread_test_rwlock8();
+int pthread_test_rwlock9();
 
 int pthread_test_priority1();
 int pthread_test_priority2();
+int pthread_test_priority3();
+int pthread_test_priority4();
 
 int pthread_test_inherit1();
 
@@ -273,6 +301,11 @@ int pthread_test_bench1();
 int pthread_test_bench2();
 int pthread_test_bench3();
 int pthread_test_bench4();
+int pthread_test_bench5();
+int pthread_test_bench6();
+int pthread_test_bench7();
+int pthread_test_bench8();
+int pthread_test_bench9();
 
 int pthread_test_exception1();
 int pthread_test_exception2();
@@ -1,5 +1,24 @@
 #include "pte_osal.h"
 #include "test.h"
+#include "benchtest.h"
+
+/*
+ * Benchmark report mode.
+ *
+ * Build with -DPTE_BENCH_REPORT=\"<path>\" to run the benchmarks once,
+ * instead of the full test suite, and write every result to <path> as
+ * CSV (or JSON with -DPTE_BENCH_FORMAT=BENCH_FORMAT_JSON). If
+ * -DPTE_BENCH_BASELINE=\"<path>\" names a CSV report from an earlier
+ * run, results whose median is more than PTE_BENCH_THRESHOLD percent
+ * slower than the baseline are listed as regressions.
+ */
+#ifndef PTE_BENCH_FORMAT
+#define PTE_BENCH_FORMAT BENCH_FORMAT_CSV
+#endif
+
+#ifndef PTE_BENCH_THRESHOLD
+#define PTE_BENCH_THRESHOLD 10
+#endif
 
 const char * error_string;
 
@@ -24,6 +43,9 @@ static void runBarrierTests(void)
 
   printf("Barrier test #5\n");
   pthread_test_barrier5();
+
+  printf("Barrier test #6\n");
+  pthread_test_barrier6();
 }
 
 static void runSemTests(void)
@@ -51,6 +73,15 @@ static void runSemTests(void)
   printf("Semaphore test #6\n");
   pthread_test_semaphore6();
 
+  printf("Semaphore test #7\n");
+  pthread_test_semaphore7();
+
+  printf("Semaphore test #8\n");
+  pthread_test_semaphore8();
+
+  printf("Semaphore test #9\n");
+  pthread_test_semaphore9();
+
 }
 
 static void runThreadTests(int iteration)
@@ -114,6 +145,12 @@ static void runThreadTests(int iteration)
   printf("Priority test #2\n");
   pthread_test_priority2();
 
+  printf("Priority test #3\n");
+  pthread_test_priority3();
+
+  printf("Priority test #4\n");
+  pthread_test_priority4();
+
   printf("Affinity test #1\n");
   pthread_test_affinity1();
 
@@ -161,6 +198,9 @@ static void runMiscTests(void)
   printf("Once test #4\n");
   pthread_test_once4();
 
+  printf("Once test #5\n");
+  pthread_test_once5();
+
   printf("TSD test #1\n");
   pthread_test_tsd1();
 
@@ -175,6 +215,30 @@ static void runMiscTests(void)
   printf("Detach test #1\n");
   pthread_test_detach1();
 
+  printf("Trace test #1\n");
+  pthread_test_trace1();
+
+  printf("Stats test #1\n");
+  pthread_test_stats1();
+
+  printf("Waits test #1\n");
+  pthread_test_waits1();
+
+  printf("Hooks test #1\n");
+  pthread_test_hooks1();
+
+  printf("Profile test #1\n");
+  pthread_test_profile1();
+
+  printf("Inline test #1\n");
+  pthread_test_inline1();
+
+  printf("Cputime test #1\n");
+  pthread_test_cputime1();
+
+  printf("Concurrency test #1\n");
+  pthread_test_concurrency1();
+
 }
 
 static void runMutexTests(void)
@@ -261,6 +325,15 @@ static void runMutexTests(void)
   printf("Mutex test #8r\n");
   pthread_test_mutex8r();
 
+  printf("Mutex test #9\n");
+  pthread_test_mutex9();
+
+  printf("Mutex test #10\n");
+  pthread_test_mutex10();
+
+  printf("Mutex test #11\n");
+  pthread_test_mutex11();
+
 }
 
 static void runSpinTests()
@@ -327,6 +400,9 @@ static void runCondvarTests()
   printf("Condvar test #9\n");
   pthread_test_condvar9();
 
+  printf("Condvar test #10\n");
+  pthread_test_condvar10();
+
 }
 
 static void runStressTests()
@@ -379,6 +455,9 @@ static void runRwlockTests()
   printf("Rwlock test #8\n");
   pthread_test_rwlock8();
 
+  printf("Rwlock test #9\n");
+  pthread_test_rwlock9();
+
 }
 
 static void runCancelTests()
@@ -421,20 +500,45 @@ static void runCancelTests()
   pthread_test_cleanup3();
 }
 
+/*
+ * Benchmarks are tagged with a suite name so their results can be told
+ * apart in the machine-readable report (see PTE_BENCH_REPORT below).
+ */
+static void runBench(const char * suite, int (*bench)())
+{
+  benchSetSuite(suite);
+  bench();
+}
+
 static void runBenchTests()
 {
 
   printf("Benchmark test #1\n");
-  pthread_test_bench1();
+  runBench("bench1", pthread_test_bench1);
 
   printf("Benchmark test #2\n");
-  pthread_test_bench2();
+  runBench("bench2", pthread_test_bench2);
 
   printf("Benchmark test #3\n");
-  pthread_test_bench3();
+  runBench("bench3", pthread_test_bench3);
 
   printf("Benchmark test #4\n");
-  pthread_test_bench4();
+  runBench("bench4", pthread_test_bench4);
+
+  printf("Benchmark test #5\n");
+  runBench("bench5", pthread_test_bench5);
+
+  printf("Benchmark test #6\n");
+  runBench("bench6", pthread_test_bench6);
+
+  printf("Benchmark test #7\n");
+  runBench("bench7", pthread_test_bench7);
+
+  printf("Benchmark test #8\n");
+  runBench("bench8", pthread_test_bench8);
+
+  printf("Benchmark test #9\n");
+  runBench("bench9", pthread_test_bench9);
 }
 
 static void runExceptionTests()
@@ -452,6 +556,42 @@ static void runExceptionTests()
   pthread_test_exception3();
 }
 
+#ifdef PTE_BENCH_REPORT
+static void runBenchReport()
+{
+  FILE * fp;
+
+  if ((fp = fopen(PTE_BENCH_REPORT, "w")) == NULL)
+    {
+      printf("Failed to open benchmark report %s\n", PTE_BENCH_REPORT);
+      return;
+    }
+
+  benchReportOpen(fp, PTE_BENCH_FORMAT);
+  runBenchTests();
+  benchReportClose();
+  fclose(fp);
+
+  printf("Benchmark report written to %s\n", PTE_BENCH_REPORT);
+
+#ifdef PTE_BENCH_BASELINE
+  {
+    int regressions = benchCompareBaseline(PTE_BENCH_BASELINE, PTE_BENCH_THRESHOLD);
+
+    if (regressions < 0)
+      {
+        printf("Failed to read benchmark baseline %s\n", PTE_BENCH_BASELINE);
+      }
+    else
+      {
+        printf("%d benchmark regression(s) beyond %g%% against %s\n",
+               regressions, (double) (PTE_BENCH_THRESHOLD), PTE_BENCH_BASELINE);
+      }
+  }
+#endif
+}
+#endif
+
 void pte_test_main()
 {
   int i;
@@ -462,6 +602,11 @@ void pte_test_main()
       return;
     }
 
+#ifdef PTE_BENCH_REPORT
+  runBenchReport();
+  return;
+#endif
+
   printf("Running tests...\n");
   for (i=0; i<2; i++)
     {
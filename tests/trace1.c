@@ -0,0 +1,110 @@
+/*
+ * trace1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ *
+ * Test event tracing: contend a mutex between two threads with tracing
+ * enabled and check the exported document holds the wait span.
+ * Passes trivially when the library was built without PTE_TRACE.
+ *
+ * Depends on API functions:
+ *	pthread_trace_enable_np()
+ *	pthread_trace_export_np()
+ *	pthread_mutex_lock()
+ *	pthread_mutex_unlock()
+ */
+
+#include <string.h>
+
+#include "test.h"
+
+#define OUTPUT_SIZE 65536
+
+static pthread_mutex_t mx = PTHREAD_MUTEX_INITIALIZER;
+
+static char output[OUTPUT_SIZE];
+static int outputLength = 0;
+
+static void
+collect(const char * text, void * arg)
+{
+  int n = (int) strlen(text);
+
+  assert(arg == (void *) output);
+
+  if (outputLength + n < OUTPUT_SIZE)
+    {
+      memcpy(output + outputLength, text, n + 1);
+      outputLength += n;
+    }
+}
+
+static void *
+locker(void * arg)
+{
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_mutex_unlock(&mx) == 0);
+
+  return 0;
+}
+
+int pthread_test_trace1()
+{
+  pthread_t t;
+
+  mx = PTHREAD_MUTEX_INITIALIZER;
+
+  if (pthread_trace_enable_np(1) == ENOSYS)
+    {
+      assert(pthread_trace_export_np(collect, output) == ENOSYS);
+      return 0;
+    }
+
+  assert(pthread_trace_export_np(NULL, NULL) == EINVAL);
+
+  assert(pthread_mutex_lock(&mx) == 0);
+  assert(pthread_create(&t, NULL, locker, NULL) == 0);
+  pte_osThreadSleep(50);
+  assert(pthread_mutex_unlock(&mx) == 0);
+  assert(pthread_join(t, NULL) == 0);
+
+  assert(pthread_trace_enable_np(0) == 0);
+
+  outputLength = 0;
+  output[0] = '\0';
+  assert(pthread_trace_export_np(collect, output) == 0);
+
+  assert(strncmp(output, "{\"traceEvents\":[", 16) == 0);
+  assert(strstr(output, "\"name\":\"mutex_wait\",\"ph\":\"B\"") != NULL);
+  assert(strstr(output, "\"name\":\"mutex_wait\",\"ph\":\"E\"") != NULL);
+  assert(strstr(output, "\"name\":\"thread_create\"") != NULL);
+  assert(strcmp(output + outputLength - 4, "\n]}\n") == 0);
+
+  assert(pthread_mutex_destroy(&mx) == 0);
+
+  return 0;
+}
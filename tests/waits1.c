@@ -0,0 +1,181 @@
+/*
+ * waits1.c
+ *
+ *
+ * --------------------------------------------------------------------------
+ *
+ *      Pthreads-embedded (PTE) - POSIX Threads Library for embedded systems
+ *      Copyright(C) 2008 Jason Schmidlapp
+ *
+ *      Contact Email: jschmidlapp@users.sourceforge.net
+ *
+ *      This library is free software; you can redistribute it and/or
+ *      modify it under the terms of the GNU Lesser General Public
+ *      License as published by the Free Software Foundation; either
+ *      version 2 of the License, or (at your option) any later version.
+ *
+ *      This library is distributed in the hope that it will be useful,
+ *      but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *      MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *      Lesser General Public License for more details.
+ *
+ *      You should have received a copy of the GNU Lesser General Public
+ *      License along with this library in the file COPYING.LIB;
+ *      if not, write to the Free Software Foundation, Inc.,
+ *      59 Temple Place - Suite 330, Boston, MA 02111-1307, USA
+ *
+ * --------------------------------------------------------------------------
+ *
+ *
+ * Test the blocked-thread report: a thread waiting on a semaphore is
+ * listed as such, and two threads each timing out on the mutex the
+ * other holds are reported as a deadlock while they wait.
+ *
+ * Depends on API functions:
+ *	pthread_dump_waits_np()
+ *	pthread_mutex_timedlock()
+ *	sem_wait()
+ */
+
+#include <string.h>
+
+#include "test.h"
+
+#define OUTPUT_SIZE 8192
+
+static pthread_mutex_t mxA;
+static pthread_mutex_t mxB;
+static sem_t started;
+static sem_t go;
+static sem_t release;
+
+static char output[OUTPUT_SIZE];
+static int outputLength;
+
+static void
+collect(const char * text, void * arg)
+{
+  int n = (int) strlen(text);
+
+  if (outputLength + n < OUTPUT_SIZE)
+    {
+      memcpy(output + outputLength, text, n + 1);
+      outputLength += n;
+    }
+}
+
+static int
+dump(void)
+{
+  outputLength = 0;
+  output[0] = '\0';
+
+  return pthread_dump_waits_np(collect, NULL);
+}
+
+static void *
+sleeper(void * arg)
+{
+  assert(sem_wait(&release) == 0);
+
+  return 0;
+}
+
+static void *
+crosser(void * arg)
+{
+  pthread_mutex_t * mine = arg ? &mxA : &mxB;
+  pthread_mutex_t * theirs = arg ? &mxB : &mxA;
+  struct timespec abstime;
+  struct _timeb currSysTime;
+  const unsigned int NANOSEC_PER_MILLISEC = 1000000;
+  int result;
+
+  assert(pthread_mutex_lock(mine) == 0);
+  assert(sem_post(&started) == 0);
+  assert(sem_wait(&go) == 0);
+
+  _ftime(&currSysTime);
+
+  abstime.tv_sec = currSysTime.time + 2;
+  abstime.tv_nsec = NANOSEC_PER_MILLISEC * currSysTime.millitm;
+
+  /*
+   * The first thread to time out breaks the deadlock by releasing
+   * its mutex, which may let the other one in before its timeout.
+   */
+  result = pthread_mutex_timedlock(theirs, &abstime);
+  assert(result == ETIMEDOUT || result == 0);
+
+  if (result == 0)
+    {
+      assert(pthread_mutex_unlock(theirs) == 0);
+    }
+
+  assert(pthread_mutex_unlock(mine) == 0);
+
+  return 0;
+}
+
+int pthread_test_waits1()
+{
+  pthread_mutexattr_t ma;
+  pthread_t t[2];
+  char expect[64];
+
+  assert(pthread_dump_waits_np(NULL, NULL) == EINVAL);
+
+  assert(sem_init(&started, 0, 0) == 0);
+  assert(sem_init(&go, 0, 0) == 0);
+  assert(sem_init(&release, 0, 0) == 0);
+
+  /* A plain wait, no owner and no deadlock. */
+  assert(pthread_create(&t[0], NULL, sleeper, NULL) == 0);
+  pte_osThreadSleep(100);
+
+  assert(dump() == 0);
+  sprintf(expect, "sem %p", (void *) release);
+  assert(strstr(output, expect) != NULL);
+  assert(strstr(output, "deadlock") == NULL);
+
+  assert(sem_post(&release) == 0);
+  assert(pthread_join(t[0], NULL) == 0);
+
+  /* Error checking mutexes always record their owner. */
+  assert(pthread_mutexattr_init(&ma) == 0);
+  assert(pthread_mutexattr_settype(&ma, PTHREAD_MUTEX_ERRORCHECK) == 0);
+  assert(pthread_mutex_init(&mxA, &ma) == 0);
+  assert(pthread_mutex_init(&mxB, &ma) == 0);
+
+  assert(pthread_create(&t[0], NULL, crosser, (void *) 1) == 0);
+  assert(pthread_create(&t[1], NULL, crosser, NULL) == 0);
+  assert(sem_wait(&started) == 0);
+  assert(sem_wait(&started) == 0);
+  assert(sem_post_multiple(&go, 2) == 0);
+  pte_osThreadSleep(200);
+
+  assert(dump() == EDEADLK);
+  sprintf(expect, "mutex %p", (void *) mxA);
+  assert(strstr(output, expect) != NULL);
+  sprintf(expect, "mutex %p", (void *) mxB);
+  assert(strstr(output, expect) != NULL);
+  assert(strstr(output, "owner thread") != NULL);
+  assert(strstr(output, "deadlock:") != NULL);
+
+  /* The cycle is reported once, not once per thread on it. */
+  assert(strstr(strstr(output, "deadlock:") + 1, "deadlock:") == NULL);
+
+  assert(pthread_join(t[0], NULL) == 0);
+  assert(pthread_join(t[1], NULL) == 0);
+
+  assert(dump() == 0);
+
+  assert(pthread_mutex_destroy(&mxA) == 0);
+  assert(pthread_mutex_destroy(&mxB) == 0);
+  assert(pthread_mutexattr_destroy(&ma) == 0);
+  assert(sem_destroy(&started) == 0);
+  assert(sem_destroy(&go) == 0);
+  assert(sem_destroy(&release) == 0);
+
+  return 0;
+}